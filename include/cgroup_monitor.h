@@ -0,0 +1,68 @@
+#ifndef CGROUP_MONITOR_H
+#define CGROUP_MONITOR_H
+
+#include <time.h>
+
+// ============================================================================
+// ESTRUCTURAS PÚBLICAS
+// ============================================================================
+
+/**
+ * Consumo agregado de un cgroup v2 en el último intervalo
+ */
+typedef struct {
+    const char *path;            // Ruta configurada (relativa a la raíz de cgroup v2)
+    float cpu_usage;             // Porcentaje de una CPU (puede superar 100 con varios núcleos)
+    unsigned long memory_kb;     // memory.current en kB
+    float io_kbps;               // Bytes leídos + escritos por segundo, en kB/s
+    int valid;                   // 0 si el cgroup no existe o no se pudo leer
+} CgroupSample;
+
+// ============================================================================
+// ESTRUCTURAS INTERNAS
+// ============================================================================
+
+/**
+ * Estado de un cgroup entre lecturas, para calcular tasas
+ */
+typedef struct {
+    char *path;
+    int dir_fd;                           // Descriptor del directorio del cgroup (-1 si cerrado)
+    unsigned long long prev_usage_usec;   // usage_usec de cpu.stat
+    unsigned long long prev_io_bytes;     // Suma de rbytes + wbytes de io.stat
+    struct timespec prev_timestamp;       // CLOCK_MONOTONIC de la lectura anterior
+    int has_prev;
+} CgroupState;
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+/**
+ * Define los cgroups a vigilar. Descarta el estado anterior. Si falla no
+ * queda ningún cgroup configurado; si tiene éxito la entrada i de
+ * cgroup_monitor_sample() corresponde a paths[i].
+ * @param paths: Rutas relativas a la raíz de cgroup v2 o absolutas
+ * @param count: Número de rutas
+ * @return int: 0 si es exitoso, -1 si no hay jerarquía cgroup v2 o memoria
+ */
+int cgroup_monitor_configure(char **paths, int count);
+
+/**
+ * Lee cpu.stat, memory.current e io.stat de cada cgroup configurado
+ * @param out: Buffer con espacio para todos los cgroups configurados
+ * @return int: Número de entradas escritas en out
+ */
+int cgroup_monitor_sample(CgroupSample *out);
+
+/**
+ * @return int: Número de cgroups configurados
+ */
+int cgroup_monitor_count(void);
+
+/**
+ * Cierra los descriptores y libera el estado
+ */
+void cgroup_monitor_cleanup(void);
+
+#endif // CGROUP_MONITOR_H
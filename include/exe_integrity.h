@@ -0,0 +1,89 @@
+#ifndef EXE_INTEGRITY_H
+#define EXE_INTEGRITY_H
+
+#include <time.h>
+#include <sys/types.h>
+
+// ============================================================================
+// ESTRUCTURAS PÚBLICAS
+// ============================================================================
+
+/**
+ * Señales de un ejecutable sospechoso, combinables como máscara de bits
+ */
+typedef enum {
+    EXE_FLAG_DELETED = 1 << 0,       // El binario se borró del disco después de ejecutarse
+    EXE_FLAG_MEMFD = 1 << 1          // El binario vive solo en memoria (memfd_create)
+} ExeIntegrityFlag;
+
+typedef enum {
+    EXE_HASH_PENDING = 0,            // En cola para el hilo de hashing
+    EXE_HASH_DONE,                   // sha256 es válido
+    EXE_HASH_SKIPPED                 // Supera el tamaño máximo, no se pudo leer o no hay hilo de hashing
+} ExeHashState;
+
+/**
+ * Resultado de revisar el ejecutable de un proceso
+ */
+typedef struct {
+    unsigned int flags;              // ExeIntegrityFlag
+    ExeHashState state;
+    char sha256[65];                 // Hash en hexadecimal (vacío si state != EXE_HASH_DONE)
+} ExeIntegrity;
+
+// ============================================================================
+// ESTRUCTURAS INTERNAS
+// ============================================================================
+
+/**
+ * Identidad del archivo ejecutable: un binario compartido por muchos
+ * procesos tiene la misma clave y se hashea una sola vez. Si se reemplaza
+ * en disco cambia el inodo, la fecha o el tamaño, y la clave deja de coincidir.
+ */
+typedef struct {
+    dev_t dev;
+    ino_t ino;
+    struct timespec mtime;
+    off_t size;
+} ExeKey;
+
+typedef struct {
+    ExeKey key;
+    ExeHashState state;
+    int queued;                      // 1 si hay un trabajo en la cola para esta clave
+    int used;                        // 1 si la ranura está ocupada
+    char sha256[65];
+} ExeCacheEntry;
+
+// Trabajo pendiente del hilo de hashing
+typedef struct {
+    pid_t pid;                       // Proceso por cuyo /proc/[pid]/exe se lee el binario
+    ExeKey key;
+} ExeHashJob;
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+/**
+ * Lanza el hilo que calcula los hashes en segundo plano
+ * @param max_file_kb: Tamaño máximo de un ejecutable a hashear (0 = sin límite)
+ * @return int: 0 si es exitoso, 1 si ya estaba activo, -1 si hay error
+ */
+int exe_integrity_start(unsigned long max_file_kb);
+
+/**
+ * Detiene el hilo de hashing y libera la caché
+ */
+void exe_integrity_stop(void);
+
+/**
+ * Revisa el ejecutable de un proceso sin bloquear: las señales de
+ * borrado y memfd salen de readlink(), y el hash de la caché. Si la clave
+ * no está en la caché se encola su cálculo y se devuelve EXE_HASH_PENDING.
+ * @return int: 0 si es exitoso, -1 si el proceso no tiene ejecutable
+ *              (hilo del kernel) o no se puede inspeccionar
+ */
+int exe_integrity_check(pid_t pid, ExeIntegrity *out);
+
+#endif // EXE_INTEGRITY_H
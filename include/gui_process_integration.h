@@ -88,6 +88,18 @@ void on_gui_process_new(ProcessInfo *info);
  */
 void on_gui_process_terminated(pid_t pid, const char *name);
 
+/**
+ * @brief Función callback que recibe el diff de procesos de cada ciclo
+ * 
+ * Sustituye a on_gui_process_new y on_gui_process_terminated: actualiza la
+ * vista con los procesos nuevos y modificados y registra una sola entrada de
+ * log por entrega, en lugar de una por proceso. Las alertas retenidas por el
+ * límite de notificaciones se registran como un único resumen.
+ * 
+ * @param delta Cambios acumulados desde la entrega anterior
+ */
+void on_gui_cycle_delta(const ProcessDelta *delta);
+
 /**
  * @brief Función callback para alertas de alto uso de CPU
  * 
@@ -108,6 +120,68 @@ void on_gui_high_cpu_alert(ProcessInfo *info);
  */
 void on_gui_high_memory_alert(ProcessInfo *info);
 
+/**
+ * @brief Función callback para alertas de alta tasa de E/S
+ * 
+ * Se ejecuta cuando la lectura + escritura a disco de un proceso supera
+ * UMBRAL_IO (kB/s).
+ * 
+ * @param info Información del proceso que causó la alerta
+ */
+void on_gui_high_io_alert(ProcessInfo *info);
+
+/**
+ * @brief Función callback para alertas de subárbol de procesos
+ * 
+ * Se ejecuta cuando el consumo sumado de un proceso y sus descendientes
+ * supera UMBRAL_SUBARBOL_CPU o UMBRAL_SUBARBOL_RAM aunque ningún proceso
+ * lo haga por separado (fork-bombs, workers en paralelo).
+ * 
+ * @param root Proceso raíz del subárbol, con los agregados subtree_*
+ */
+void on_gui_subtree_alert(ProcessInfo *root);
+
+/**
+ * @brief Función callback para alertas de crecimiento sostenido de memoria
+ * 
+ * Se ejecuta cuando la regresión lineal del RSS reciente de un proceso
+ * supera la pendiente y el R² configurados: una posible fuga detectada
+ * antes de que alcance UMBRAL_RAM.
+ * 
+ * @param info Proceso afectado, con mem_growth_kbps y mem_growth_r2
+ */
+void on_gui_memory_growth_alert(ProcessInfo *info);
+
+/**
+ * @brief Función callback para alertas de integridad del ejecutable
+ * 
+ * Se ejecuta cuando un proceso ejecuta un binario borrado del disco o
+ * cargado desde memoria con memfd_create, dos técnicas habituales para
+ * no dejar rastro en el sistema de archivos.
+ * 
+ * @param info Proceso afectado, con exe_flags y exe_sha256
+ */
+void on_gui_executable_alert(ProcessInfo *info);
+
+/**
+ * @brief Función callback para alertas de presión del sistema
+ * 
+ * Se ejecuta cuando la presión (PSI) de CPU, memoria o E/S se mantiene
+ * sobre PRESION_UMBRAL: el sistema entero está saturado, no un proceso.
+ * 
+ * @param pressure Última lectura de /proc/pressure con el nivel del regulador
+ * @param resource Recurso que entró en alerta
+ */
+void on_gui_pressure_alert(const SystemPressure *pressure, PsiResource resource);
+
+/**
+ * @brief Función callback cuando la presión de un recurso se normaliza
+ * 
+ * @param pressure Última lectura de /proc/pressure
+ * @param resource Recurso cuya alerta se despejó
+ */
+void on_gui_pressure_cleared(const SystemPressure *pressure, PsiResource resource);
+
 /**
  * @brief Función callback cuando una alerta se despeja
  * 
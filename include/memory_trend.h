@@ -0,0 +1,61 @@
+#ifndef MEMORY_TREND_H
+#define MEMORY_TREND_H
+
+#include <time.h>
+
+// ============================================================================
+// ESTRUCTURAS INTERNAS
+// ============================================================================
+
+/**
+ * Sumas de mínimos cuadrados de la serie RSS(t) de un proceso.
+ * Las muestras se ponderan con un olvido exponencial de constante "ventana",
+ * así que no hace falta guardarlas para descartar las viejas. Las sumas se
+ * expresan respecto de la última muestra (t = 0, rss = 0) para que los
+ * valores sigan siendo pequeños aunque el proceso viva días.
+ */
+typedef struct {
+    double weight;               // Suma de pesos (muestras efectivas en la ventana)
+    unsigned int samples;        // Muestras agregadas desde el último reinicio
+    double sum_t;                // Tiempos en segundos, relativos a la última muestra
+    double sum_tt;
+    double sum_y;                // RSS en kB, relativo a la última muestra
+    double sum_yy;
+    double sum_ty;
+    unsigned long last_rss_kb;
+    double last_step_kbps;       // Variación del RSS entre las dos últimas muestras, en kB/s
+    struct timespec last;        // CLOCK_MONOTONIC de la última muestra
+    struct timespec since;       // CLOCK_MONOTONIC de la primera muestra
+} MemoryTrend;
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+/**
+ * Descarta las muestras acumuladas
+ */
+void memory_trend_reset(MemoryTrend *trend);
+
+/**
+ * Agrega una muestra de RSS en O(1)
+ * @param now: Instante de la muestra (CLOCK_MONOTONIC)
+ * @param window_seconds: Constante de olvido: una muestra de esa antigüedad pesa ~1/e
+ */
+void memory_trend_add(MemoryTrend *trend, const struct timespec *now,
+                      unsigned long rss_kb, double window_seconds);
+
+/**
+ * Ajusta la recta RSS = a + b·t sobre las muestras ponderadas
+ * @param slope_kbps: Pendiente b en kB/s
+ * @param r2: Coeficiente de determinación del ajuste (0..1)
+ * @return int: 0 si hay datos suficientes, -1 si no
+ */
+int memory_trend_fit(const MemoryTrend *trend, double *slope_kbps, double *r2);
+
+/**
+ * @return double: Segundos entre la primera y la última muestra
+ */
+double memory_trend_span(const MemoryTrend *trend);
+
+#endif // MEMORY_TREND_H
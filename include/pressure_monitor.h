@@ -0,0 +1,111 @@
+#ifndef PRESSURE_MONITOR_H
+#define PRESSURE_MONITOR_H
+
+#include <time.h>
+
+// ============================================================================
+// ESTRUCTURAS PÚBLICAS
+// ============================================================================
+
+/**
+ * Recursos con Pressure Stall Information en /proc/pressure
+ */
+typedef enum {
+    PSI_CPU = 0,
+    PSI_MEMORY,
+    PSI_IO,
+    PSI_RESOURCE_COUNT
+} PsiResource;
+
+/**
+ * Nivel del regulador de carga: cuánto debe frenarse el propio monitor
+ */
+typedef enum {
+    LOAD_LEVEL_NORMAL = 0,       // Sin presión: muestreo completo
+    LOAD_LEVEL_ELEVATED,         // Intervalos estirados, sin lecturas profundas
+    LOAD_LEVEL_CRITICAL          // Además, los escaneos de disco se detienen
+} LoadLevel;
+
+/**
+ * Una línea "some" o "full" de /proc/pressure/<recurso>. Los promedios son
+ * el porcentaje del tiempo en que alguna tarea (some) o todas (full)
+ * estuvieron detenidas esperando el recurso.
+ */
+typedef struct {
+    float avg10;
+    float avg60;
+    float avg300;
+    unsigned long long total_us;     // Tiempo detenido acumulado en microsegundos
+} PsiLine;
+
+typedef struct {
+    int available;                   // 0 si el kernel no expone este recurso
+    PsiLine some;
+    PsiLine full;                    // La CPU no tiene "full" en kernels anteriores a 5.13
+} PsiStats;
+
+/**
+ * Lectura completa de la presión del sistema
+ */
+typedef struct {
+    PsiStats resources[PSI_RESOURCE_COUNT];
+    float peak_avg10;                // Máximo de some avg10 entre los recursos
+    LoadLevel level;                 // Nivel del regulador tras esta lectura
+    struct timespec taken;           // CLOCK_MONOTONIC de la lectura
+} SystemPressure;
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+/**
+ * Ajusta los umbrales del regulador de carga
+ * @param elevated: some avg10 (%) desde el que se pasa a LOAD_LEVEL_ELEVATED (0 = regulador desactivado)
+ * @param critical: some avg10 (%) desde el que se pasa a LOAD_LEVEL_CRITICAL
+ * @param hysteresis: Fracción de cada umbral por debajo de la cual se baja de nivel
+ */
+void pressure_configure(float elevated, float critical, float hysteresis);
+
+/**
+ * Lee /proc/pressure/{cpu,memory,io} y recalcula el nivel del regulador
+ * @param out: Lectura resultante (puede ser NULL)
+ * @return int: 0 si es exitoso, -1 si el kernel no expone PSI
+ */
+int pressure_update(SystemPressure *out);
+
+/**
+ * Nivel actual del regulador. Si la última lectura es más vieja que
+ * PSI_REFRESH_MS se vuelve a leer, así que sirve también a los módulos que
+ * corren sin el monitor de procesos.
+ */
+LoadLevel pressure_get_level(void);
+
+/**
+ * @return int: Factor por el que se multiplican los intervalos de muestreo en
+ *              ese nivel (1, 2 o 4)
+ */
+int pressure_interval_factor(LoadLevel level);
+
+/**
+ * Punto de pausa para trabajos largos (hashes, escaneos de disco). Con
+ * presión elevada cede una pausa breve; con presión crítica espera a que
+ * baje, hasta un máximo por punto. Ninguna pausa excede lo que le queda al
+ * presupuesto del trabajo, así que un escaneo de miles de archivos se
+ * retrasa como mucho ese presupuesto en total.
+ * @param budget_ms: Pausa total que aún puede gastar el trabajo; se le descuenta lo esperado (NULL = sin tope total)
+ * @param keep_running: Bandera de ejecución del llamador; la espera termina en cuanto vale 0 (puede ser NULL)
+ * @return int: Milisegundos esperados
+ */
+int pressure_throttle_point(int *budget_ms, volatile int *keep_running);
+
+/**
+ * @return const char*: Nombre del recurso para mensajes ("CPU", "memoria", "E/S")
+ */
+const char* pressure_resource_name(PsiResource resource);
+
+/**
+ * @return const char*: Nombre del nivel del regulador para mensajes
+ */
+const char* pressure_level_name(LoadLevel level);
+
+#endif // PRESSURE_MONITOR_H
@@ -0,0 +1,54 @@
+#ifndef PROC_CONNECTOR_H
+#define PROC_CONNECTOR_H
+
+#include <sys/types.h>
+
+// ============================================================================
+// EVENTOS DEL CONECTOR DE PROCESOS (NETLINK_CONNECTOR / CN_PROC)
+// ============================================================================
+
+/**
+ * Tipos de evento que el kernel notifica y que interesan al monitor.
+ * Solo se reportan procesos (líder del grupo de hilos), nunca hilos sueltos.
+ */
+typedef enum {
+    PROC_CONN_FORK,     // Se creó un proceso nuevo
+    PROC_CONN_EXEC,     // Un proceso cargó un ejecutable nuevo
+    PROC_CONN_EXIT      // Un proceso terminó
+} ProcConnectorEvent;
+
+/**
+ * Manejador invocado desde el hilo del conector por cada evento recibido
+ * @param event: Tipo de evento
+ * @param pid: PID del proceso afectado
+ */
+typedef void (*ProcConnectorHandler)(ProcConnectorEvent event, pid_t pid);
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+/**
+ * Se suscribe al flujo de eventos fork/exec/exit del kernel y lanza un hilo
+ * que despacha cada evento al manejador.
+ *
+ * Requiere CAP_NET_ADMIN. Si no se dispone del permiso o el kernel no tiene
+ * el conector, devuelve -1 y el llamador debe seguir usando sondeo.
+ *
+ * @param handler: Función a invocar por cada evento
+ * @return int: 0 si es exitoso, 1 si ya estaba activo, -1 si no está disponible
+ */
+int proc_connector_start(ProcConnectorHandler handler);
+
+/**
+ * Cancela la suscripción y espera a que termine el hilo del conector.
+ * No debe llamarse sosteniendo un lock que tome el manejador.
+ */
+void proc_connector_stop(void);
+
+/**
+ * @return int: 1 si el conector está recibiendo eventos, 0 si no
+ */
+int proc_connector_is_active(void);
+
+#endif // PROC_CONNECTOR_H
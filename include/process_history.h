@@ -0,0 +1,98 @@
+#ifndef PROCESS_HISTORY_H
+#define PROCESS_HISTORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include <sys/types.h>
+
+// ============================================================================
+// ESTRUCTURAS PÚBLICAS
+// ============================================================================
+
+/**
+ * Punto de la serie histórica de un proceso, ya decodificado
+ */
+typedef struct {
+    double elapsed_seconds;      // Segundos desde el inicio del historial (reloj monótono)
+    float cpu_usage;             // Porcentaje de CPU
+    float mem_usage;             // Porcentaje de RAM
+    unsigned long rss_kb;        // Memoria residente en kB
+    unsigned long io_kbps;       // Tasa de E/S en kB/s
+} ProcessHistoryPoint;
+
+// ============================================================================
+// ESTRUCTURAS INTERNAS
+// ============================================================================
+
+/**
+ * Muestra compacta en punto fijo tal como se guarda en la arena (16 bytes)
+ */
+typedef struct {
+    uint32_t time_cs;            // Centésimas de segundo desde el inicio del historial
+    uint32_t rss_kb;
+    uint32_t io_kbps;
+    uint16_t cpu_x10;            // CPU% * 10 (satura en 6553.5%)
+    uint16_t mem_x100;           // RAM% * 100
+} HistorySample;
+
+/**
+ * Cabecera del anillo de un proceso
+ */
+typedef struct {
+    pid_t pid;                   // 0 si el anillo está libre
+    unsigned long starttime;
+    uint16_t head;               // Próxima posición a escribir
+    uint16_t count;              // Muestras válidas (<= longitud del anillo)
+    int next_free;               // Siguiente anillo libre
+} HistoryRing;
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+/**
+ * Configura la longitud de los anillos y el tope global de memoria.
+ * Debe llamarse antes de reservar anillos; descarta el historial existente.
+ * @param samples_per_process: Muestras que conserva cada proceso
+ * @param max_bytes: Tope de memoria para toda la arena de muestras
+ */
+void history_configure(int samples_per_process, size_t max_bytes);
+
+/**
+ * Reserva un anillo para un proceso
+ * @return int: Índice del anillo, o -1 si se alcanzó el tope de memoria
+ */
+int history_alloc(pid_t pid, unsigned long starttime);
+
+/**
+ * Libera el anillo de un proceso terminado
+ */
+void history_release(int ring);
+
+/**
+ * Agrega una muestra al anillo, sobrescribiendo la más antigua si está lleno
+ * @param now: Instante de la muestra (CLOCK_MONOTONIC)
+ */
+void history_record(int ring, const struct timespec *now, float cpu_usage, float mem_usage,
+                    unsigned long rss_kb, unsigned long io_kbps);
+
+/**
+ * Copia la serie de un proceso, de la muestra más antigua a la más reciente
+ * @param out: Buffer de salida
+ * @param max_points: Capacidad del buffer
+ * @return int: Puntos copiados, o -1 si el proceso no tiene historial
+ */
+int history_get_series(pid_t pid, ProcessHistoryPoint *out, int max_points);
+
+/**
+ * @return int: Muestras que conserva cada anillo
+ */
+int history_length(void);
+
+/**
+ * Libera toda la arena
+ */
+void history_cleanup(void);
+
+#endif // PROCESS_HISTORY_H
@@ -4,42 +4,164 @@
 #include <pthread.h>
 #include <time.h>
 #include <sys/types.h>
+#include "process_history.h"
+#include "memory_trend.h"
+#include "exe_integrity.h"
+#include "pressure_monitor.h"
 
 #define CONFIG_PATH "./matcomguard.conf"
 
 // ===== ESTRUCTURAS PÚBLICAS =====
 
+// Hilos más activos que se reportan por proceso en el modo por tareas
+#define PROCESS_HOT_THREADS 3
+
 typedef struct {
-    pid_t pid;
-    char name[256];
+    pid_t tid;
+    char name[16];           // comm del hilo (el kernel lo limita a 15 caracteres)
     float cpu_usage;
-    float cpu_time;
-    float mem_usage;
+} ThreadCpuInfo;
+
+/**
+ * Estado que el monitor acumula de un proceso entre muestras: máquina de
+ * alertas, agregados del subárbol, tendencia del RSS e integridad del
+ * ejecutable. Una muestra nueva reemplaza el resto de ProcessInfo y deja
+ * este bloque intacto.
+ */
+typedef struct {
     time_t inicio_alerta;
     int alerta_activa;
     int exceeds_thresholds;  // 1 si excede umbrales, 0 si no
     time_t first_threshold_exceed; // Momento en que empezó a exceder umbrales
+    unsigned int alert_kinds; // ProcessAlertKind que dispararon la alerta activa
+    unsigned int notified_kinds;   // Alertas activas cuya activación se notificó
+    unsigned int suppressed_kinds; // Activaciones retenidas, ya contadas en el resumen
+    time_t last_alert_emitted;     // Última activación notificada (enfriamiento)
+    float subtree_cpu_usage; // CPU del proceso más la de todos sus descendientes
+    float subtree_mem_usage; // RAM% sumada del subárbol
+    unsigned long subtree_rss_kb;
+    int subtree_processes;   // Procesos del subárbol, incluido este
+    int subtree_alert;       // 1 si el subárbol que cuelga de este proceso está en alerta
+    float mem_growth_kbps;   // Pendiente del ajuste lineal del RSS reciente, en kB/s
+    float mem_growth_r2;     // R² de ese ajuste (1 = crecimiento perfectamente lineal)
+    int mem_growth_alert;    // 1 si el RSS crece de forma sostenida (posible fuga)
+    unsigned int exe_flags;  // ExeIntegrityFlag del ejecutable (borrado del disco, memfd)
+    char exe_sha256[65];     // SHA-256 de /proc/[pid]/exe (vacío si no se calculó)
+} ProcessState;
+
+typedef struct {
+    pid_t pid;
+    pid_t ppid;              // Proceso padre según /proc/[pid]/stat
+    char name[256];
+    float cpu_usage;
+    float cpu_time;
+    float mem_usage;
     int is_whitelisted;      // 1 si está en whitelist, 0 si no
+    unsigned long rss_kb;    // Memoria residente en kB
+    unsigned long pss_kb;    // Pss de smaps_rollup en kB (0 si no se escaló la medición)
+    unsigned long swap_kb;   // Swap de smaps_rollup en kB
+    int mem_precise;         // 1 si mem_usage se calculó con PSS en lugar de RSS
+    float io_kbps;           // Tasa total de E/S a disco en kB/s (lectura + escritura)
+    float io_read_kbps;      // read_bytes de /proc/[pid]/io por segundo, en kB
+    float io_write_kbps;     // write_bytes de /proc/[pid]/io por segundo, en kB
+    float syscr_rate;        // Llamadas de lectura por segundo
+    float syscw_rate;        // Llamadas de escritura por segundo
+    ThreadCpuInfo hot_threads[PROCESS_HOT_THREADS];  // De mayor a menor CPU (modo por tareas)
+    int num_hot_threads;
+    int is_cgroup;           // 1 si la entrada agrega un cgroup v2 (pid sintético negativo)
+    ProcessState state;      // Estado acumulado entre muestras
 } ProcessInfo;
 
 typedef struct {
     float max_cpu_usage;
     float max_ram_usage;
+    float max_io_kbps;        // Umbral de E/S en kB/s (0 = sin alertas de E/S)
+    float subtree_max_cpu;    // Umbral de CPU de un subárbol de procesos (0 = sin alertas)
+    float subtree_max_ram;    // Umbral de RAM% de un subárbol de procesos (0 = sin alertas)
     int check_interval;
     int alert_duration;
     char **white_list;
     int num_white_processes;
+    int use_proc_connector;   // 1 para recibir fork/exec/exit del kernel en tiempo real
+    int sampler_threads;      // Hilos que leen /proc en paralelo (1 = secuencial)
+    int history_length;       // Muestras de historial por proceso (0 = sin historial)
+    int history_max_kb;       // Tope de memoria de todo el historial en KB
+    int fast_interval_ms;     // Periodo de muestreo rápido (procesos calientes o en investigación)
+    float fast_sampling_fraction; // Fracción de un umbral a partir de la cual se muestrea rápido
+    float pss_fraction;       // Fracción de max_ram_usage desde la que se mide PSS (0 = solo RSS)
+    int slow_interval;        // Periodo en segundos para procesos inactivos o en whitelist
+    int task_monitoring;      // 1 para leer /proc/[pid]/task de los procesos calientes
+    float task_cpu_floor;     // CPU% a partir del cual se desciende a los hilos
+    char **cgroup_paths;      // cgroups v2 vigilados como un todo (servicios, contenedores)
+    int num_cgroups;
+    int growth_window;        // Ventana en segundos del detector de fugas (0 = desactivado)
+    float growth_min_kbps;    // Pendiente mínima del RSS para alertar, en kB/s
+    float growth_min_r2;      // R² mínimo para considerar el crecimiento sostenido
+    float alert_hysteresis;   // Fracción de cada umbral por debajo de la cual se despeja una alerta
+    int alert_cooldown;       // Segundos sin volver a notificar a un proceso ya notificado
+    int alerts_per_minute;    // Ritmo del límite global de notificaciones (0 = sin límite)
+    int alert_burst;          // Notificaciones que el límite global admite de golpe
+    int exe_integrity;        // 1 para hashear los ejecutables y detectar binarios borrados o memfd
+    int exe_hash_max_kb;      // Tamaño máximo de un ejecutable a hashear en KB (0 = sin límite)
+    float pressure_threshold; // some avg10 (%) de PSI que frena el monitor y, sostenido, alerta (0 = sin PSI)
+    float pressure_critical;  // some avg10 (%) de PSI desde el que se detienen los escaneos profundos
 } Config;
 
 // ===== CALLBACKS PARA EVENTOS =====
 
-// Estructura para callbacks de eventos
+// Tipos de alerta, combinables como máscara de bits
+typedef enum {
+    ALERT_KIND_CPU = 1 << 0,
+    ALERT_KIND_MEMORY = 1 << 1,
+    ALERT_KIND_IO = 1 << 2,
+    ALERT_KIND_SUBTREE = 1 << 3,
+    ALERT_KIND_MEMORY_GROWTH = 1 << 4,
+    ALERT_KIND_EXECUTABLE = 1 << 5
+} ProcessAlertKind;
+
+// Entrada del diff de un ciclo: copia del proceso al registrar el cambio
+typedef struct {
+    ProcessInfo info;
+    unsigned int alert_kinds;   // En alertas levantadas y despejadas: ProcessAlertKind implicados
+} ProcessDeltaEntry;
+
+// Cambios acumulados desde la entrega anterior. Los arrays solo son
+// válidos durante la llamada a on_cycle_delta.
+typedef struct {
+    unsigned long cycle;                      // Número de entrega, creciente
+    const ProcessDeltaEntry *added;           // Procesos nuevos (o que hicieron exec)
+    int num_added;
+    const ProcessDeltaEntry *removed;         // Procesos terminados
+    int num_removed;
+    const ProcessDeltaEntry *changed;         // Procesos con cambios de CPU, RAM o nombre
+    int num_changed;
+    const ProcessDeltaEntry *alerts_raised;
+    int num_alerts_raised;
+    const ProcessDeltaEntry *alerts_cleared;
+    int num_alerts_cleared;
+    int num_alerts_suppressed;                // Activaciones retenidas por enfriamiento o por el
+                                              // límite global desde el resumen anterior
+    const SystemPressure *pressure;           // Última lectura de PSI (NULL si no está disponible)
+    unsigned int stalls_raised;               // Recursos (1 << PsiResource) que entraron en alerta
+    unsigned int stalls_cleared;              // Recursos cuya alerta de presión se despejó
+} ProcessDelta;
+
+// Estructura para callbacks de eventos.
+// on_cycle_delta recibe un único diff por ciclo; los callbacks por evento se
+// siguen llamando, a partir del mismo diff, para los clientes existentes.
 typedef struct {
     void (*on_new_process)(ProcessInfo *info);
     void (*on_process_terminated)(pid_t pid, const char *name);
     void (*on_high_cpu_alert)(ProcessInfo *info);
     void (*on_high_memory_alert)(ProcessInfo *info);
     void (*on_alert_cleared)(ProcessInfo *info);
+    void (*on_high_io_alert)(ProcessInfo *info);
+    void (*on_subtree_alert)(ProcessInfo *root);
+    void (*on_memory_growth_alert)(ProcessInfo *info);
+    void (*on_executable_alert)(ProcessInfo *info);
+    void (*on_pressure_alert)(const SystemPressure *pressure, PsiResource resource);
+    void (*on_pressure_cleared)(const SystemPressure *pressure, PsiResource resource);
+    void (*on_cycle_delta)(const ProcessDelta *delta);
 } ProcessCallbacks;
 
 // Estructura para estadísticas de monitoreo
@@ -47,26 +169,242 @@ typedef struct {
     int total_processes;
     int high_cpu_count;
     int high_memory_count;
+    int high_io_count;
     int active_alerts;
     int is_active;
     int check_interval;
 } MonitoringStats;
 
+// Métricas por las que se mantiene un ranking de los procesos más pesados
+#define PROCESS_TOP_K 32
+typedef enum {
+    TOP_BY_CPU = 0,
+    TOP_BY_RSS,
+    TOP_BY_IO,
+    TOP_METRIC_COUNT
+} ProcessTopMetric;
+
+// Resultado inmutable de un ciclo de monitoreo, publicado con conteo de referencias.
+// Se obtiene con acquire_process_snapshot() y se devuelve con release_process_snapshot().
+typedef struct {
+    ProcessInfo *processes;   // Procesos vivos al cierre del ciclo
+    int count;
+    int capacity;
+    int high_cpu_count;
+    int high_memory_count;
+    int high_io_count;
+    int active_alerts;
+    int top[TOP_METRIC_COUNT][PROCESS_TOP_K];  // Índices en processes, de mayor a menor
+    int top_count[TOP_METRIC_COUNT];
+    ProcessInfo *cgroups;     // Cgroups configurados, con su estado de alerta
+    int cgroup_count;
+    int cgroup_capacity;
+    SystemPressure pressure;  // Lectura de PSI del ciclo (válida si pressure_available)
+    int pressure_available;
+    unsigned int stalled;     // Recursos (1 << PsiResource) con alerta de presión activa
+    unsigned long cycle;      // Número de ciclo que lo produjo
+    time_t timestamp;         // Momento de publicación
+    int refcount;             // Uso interno
+} ProcessSnapshot;
+
 // ===== ESTRUCTURAS INTERNAS =====
 
-// Estructura para estadísticas de /proc/[pid]/stat
+// Estructura para estadísticas de /proc/[pid]/stat (obtenidas con una sola lectura)
 typedef struct {
+    pid_t pid;
+    char name[64];                 // Campo comm, sin paréntesis (el kernel lo limita a 15 caracteres)
+    char state;                    // R, S, D, Z, ...
+    pid_t ppid;
     unsigned long utime;
     unsigned long stime;
     unsigned long starttime;
-} ProcStat;
+    unsigned long vsize;           // Memoria virtual en bytes
+    long rss;                      // Memoria residente en páginas
+    int whitelisted;               // Veredicto de la whitelist para (pid, starttime)
+    int has_pss;                   // 1 si se leyó /proc/[pid]/smaps_rollup
+    unsigned long pss_kb;          // Memoria proporcional: comparte las páginas entre sus usuarios
+    unsigned long swap_kb;
+    int has_io;                    // 1 si se pudo leer /proc/[pid]/io
+    unsigned long long read_bytes;
+    unsigned long long write_bytes;
+    unsigned long long syscr;
+    unsigned long long syscw;
+    struct timespec taken;         // CLOCK_MONOTONIC del momento de la lectura
+} ProcSample;
 
-// Estructura auxiliar para rastrear procesos activos
+// Constantes del sistema capturadas una sola vez al inicio de cada ciclo
 typedef struct {
-    ProcessInfo info;
-    int encontrado;  // Flag para marcar si fue encontrado en el ciclo actual
+    unsigned long mem_total_kb;    // MemTotal de /proc/meminfo
+    long clk_tck;                  // sysconf(_SC_CLK_TCK)
+    long num_cpus;                 // sysconf(_SC_NPROCESSORS_ONLN)
+    long page_size_kb;             // sysconf(_SC_PAGESIZE) en kB
+    unsigned long pss_min_rss_kb;  // RSS desde el que se lee smaps_rollup (0 = nunca)
+    double uptime_seconds;         // Primer campo de /proc/uptime
+    struct timespec now;           // CLOCK_MONOTONIC del inicio del ciclo
+} CycleContext;
+
+// Muestra previa de tiempos de CPU de un proceso, indexada por (pid, starttime)
+typedef struct {
+    pid_t pid;
+    unsigned long starttime;       // Distingue reutilización de PID
+    unsigned long prev_utime;
+    unsigned long prev_stime;
+    struct timespec timestamp;     // CLOCK_MONOTONIC de la muestra
+    float last_cpu_usage;          // Último porcentaje calculado
+    // Contadores previos de /proc/[pid]/io y últimas tasas calculadas
+    int has_io;
+    struct timespec io_timestamp;
+    unsigned long long prev_read_bytes;
+    unsigned long long prev_write_bytes;
+    unsigned long long prev_syscr;
+    unsigned long long prev_syscw;
+    float last_read_kbps;
+    float last_write_kbps;
+    float last_syscr_rate;
+    float last_syscw_rate;
+    unsigned int generation;       // Último ciclo en que se consultó
+    int is_task;                   // 1 si la entrada es de un hilo (TID) y no de un proceso
+    pid_t owner;                   // Proceso al que pertenece el hilo (solo con is_task)
+    int used;                      // 1 si la ranura está ocupada
+} CpuSample;
+
+// Frecuencia de muestreo asignada a cada proceso según su actividad
+typedef enum {
+    SAMPLE_TIER_NORMAL = 0,   // Cada check_interval
+    SAMPLE_TIER_FAST,         // Cada fast_interval_ms: cerca de umbrales, en alerta o en investigación
+    SAMPLE_TIER_SLOW          // Cada slow_interval: inactivo o en whitelist
+} SamplingTier;
+
+// Entrada de un heap mínimo acotado para calcular rankings
+typedef struct {
+    float key;
+    int index;
+} TopHeapEntry;
+
+// Registro frío de una ranura del slab de procesos: lo que solo se lee al
+// evaluar alertas, al publicar o al notificar. pid, starttime, cpu, mem, io
+// y el estado de la ranura están únicamente en ProcessColumns, y el nombre
+// en el pool de cadenas; slot_to_info() arma la ProcessInfo pública.
+typedef struct {
+    const char *name;             // Nombre internado (string_pool_intern)
+    pid_t ppid;
+    float cpu_time;
+    int is_whitelisted;
+    unsigned long rss_kb;
+    unsigned long pss_kb;
+    unsigned long swap_kb;
+    int mem_precise;
+    float io_read_kbps;
+    float io_write_kbps;
+    float syscr_rate;
+    float syscw_rate;
+    ThreadCpuInfo hot_threads[PROCESS_HOT_THREADS];
+    int num_hot_threads;
+    ProcessState state;           // Estado acumulado entre muestras
+    int next_free;   // Siguiente ranura libre (solo válido si la ranura no está en uso)
+    int history_ring;         // Anillo de historial asignado, o -1 si no tiene
+    int investigated;         // 1 si se muestrea a alta frecuencia
+    SamplingTier sampling_tier;
+    struct timespec next_sample;  // CLOCK_MONOTONIC de la próxima lectura programada
+    // Árbol de procesos: enlaces entre ranuras del slab (-1 si no hay)
+    int parent_slot;
+    int first_child;
+    int next_sibling;
+    int prev_sibling;
+    int subtree_child_exceeds;    // Algún subárbol hijo supera los umbrales de subárbol
+    time_t subtree_exceeds_since; // Inicio del exceso sostenido del subárbol (0 si no excede)
+    MemoryTrend memory_trend;     // Regresión incremental del RSS para detectar fugas
+    int exe_checked;              // 1 si el ejecutable ya se revisó (y hasheó) para este exec
 } ActiveProcess;
 
+// Estado de una ranura en ProcessColumns.flags, combinable como máscara de bits
+typedef enum {
+    SLOT_IN_USE = 1 << 0,            // La ranura contiene un proceso vivo
+    SLOT_FOUND = 1 << 1,             // Visto en el ciclo actual
+    SLOT_FAST = 1 << 2,              // En el nivel de muestreo rápido
+    SLOT_SKIPPED = 1 << 3,           // Vigente pero sin lectura en el ciclo actual
+    SLOT_ALERT = 1 << 4              // Alerta por umbrales activa (state.alerta_activa)
+} ProcessSlotFlag;
+
+// Columnas calientes del slab de procesos (estructura de arrays, indexadas
+// por ranura). Son el único almacén de estos campos: los recorridos que
+// solo miran identidad, consumo o estado leen unos pocos bytes contiguos
+// por proceso en lugar de una ActiveProcess completa. Solo add_process() y
+// update_process() escriben los valores muestreados y SLOT_ALERT.
+typedef struct {
+    pid_t *pid;
+    unsigned long *starttime;        // Identifica la instancia del proceso ante reutilización de PID
+    float *cpu_usage;
+    float *mem_usage;
+    float *io_kbps;
+    unsigned char *flags;            // ProcessSlotFlag
+} ProcessColumns;
+
+// Límite global de notificaciones de alerta (cubo de fichas)
+typedef struct {
+    double tokens;                 // Fichas disponibles (como máximo alert_burst)
+    struct timespec last_refill;   // CLOCK_MONOTONIC de la última recarga
+    int initialized;
+    int rate_limited;              // Activaciones retenidas por falta de fichas
+    int deduplicated;              // Activaciones retenidas por el enfriamiento del proceso
+    time_t last_summary;           // Último resumen de alertas suprimidas
+} AlertRateLimiter;
+
+// Estado de las alertas de presión del sistema (PSI), una por recurso
+typedef struct {
+    SystemPressure last;             // Última lectura
+    int available;                   // -1 sin leer aún, 0 sin PSI en el kernel, 1 disponible
+    LoadLevel level;                 // Nivel del regulador informado por última vez
+    unsigned int stalled;            // Recursos (1 << PsiResource) con alerta activa
+    unsigned int raised;             // Transiciones pendientes de entregar en el diff
+    unsigned int cleared;
+    time_t first_exceed[PSI_RESOURCE_COUNT];  // Inicio del exceso aún no confirmado (0 = ninguno)
+} PressureAlertState;
+
+// Lista de entradas de un tipo de cambio pendientes de entregar
+typedef enum {
+    DELTA_ADDED = 0,
+    DELTA_REMOVED,
+    DELTA_CHANGED,
+    DELTA_ALERT_RAISED,
+    DELTA_ALERT_CLEARED,
+    DELTA_LIST_COUNT
+} DeltaListKind;
+
+typedef struct {
+    ProcessDeltaEntry *entries;
+    int count;
+    int capacity;
+} DeltaList;
+
+// Texto de log acumulado bajo el mutex global y escrito tras soltarlo
+typedef struct {
+    char *text;
+    size_t length;
+    size_t capacity;
+} LogBuffer;
+
+// Diff extraído bajo el mutex global para entregarlo sin él. Sus listas se
+// intercambian con las pendientes, así que la memoria se reutiliza.
+typedef struct {
+    DeltaList lists[DELTA_LIST_COUNT];
+    LogBuffer log;
+    ProcessCallbacks callbacks;      // Copia tomada bajo el mutex al extraerlo
+    int has_callbacks;               // 0 si no había callbacks registrados
+    unsigned long cycle;
+    int num_alerts_suppressed;
+    int has_pressure;
+    SystemPressure pressure;
+    unsigned int stalls_raised;
+    unsigned int stalls_cleared;
+} DeltaBatch;
+
+// Entrada del índice PID -> ranura del slab (direccionamiento abierto)
+typedef struct {
+    pid_t pid;       // 0 indica entrada vacía
+    int slot;
+} PidIndexEntry;
+
 // ===== FUNCIONES API PÚBLICAS =====
 
 // Configuración
@@ -85,11 +423,19 @@ int start_monitoring();
 int stop_monitoring();
 int is_monitoring_active();
 void set_monitoring_interval(int seconds);
+int set_process_investigation(pid_t pid, int enabled);
 void set_process_callbacks(ProcessCallbacks *callbacks);
 
-// Funciones thread-safe para acceder a datos
+// Funciones thread-safe para acceder a datos (leen el último snapshot publicado)
 MonitoringStats get_monitoring_stats();
 ProcessInfo* get_process_list_copy(int *count);
+ProcessInfo* get_cgroup_list_copy(int *count);
+const ProcessSnapshot* acquire_process_snapshot(void);
+void release_process_snapshot(const ProcessSnapshot *snapshot);
+int get_process_history(pid_t pid, ProcessHistoryPoint *out, int max_points);
+int get_top_processes(ProcessTopMetric metric, ProcessInfo *out, int n);
+ProcessInfo* get_process_subtree(pid_t root, int *count);
+int get_system_pressure(SystemPressure *out, unsigned int *stalled);
 void cleanup_monitoring();
 
 // ===== FUNCIONES AUXILIARES PÚBLICAS =====
@@ -104,10 +450,6 @@ int process_exists(pid_t pid);
 void get_process_name(pid_t pid, char *name, size_t size);
 int is_process_whitelisted(const char *process_name);
 
-// Funciones de limpieza
-void cleanup_temp_files();
-void cleanup_stale_temp_files();
-
 // Variables globales externas
 extern Config config;
 
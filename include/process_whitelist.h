@@ -0,0 +1,88 @@
+#ifndef PROCESS_WHITELIST_H
+#define PROCESS_WHITELIST_H
+
+#include <sys/types.h>
+
+// ============================================================================
+// ESTRUCTURAS INTERNAS
+// ============================================================================
+
+/**
+ * Dato del proceso contra el que se compara un patrón.
+ * En WHITELIST se elige con los prefijos "exe:" y "cmdline:"; sin prefijo
+ * se compara el nombre (comm).
+ */
+typedef enum {
+    WHITELIST_TARGET_NAME = 0,
+    WHITELIST_TARGET_EXE,            // Destino de /proc/[pid]/exe
+    WHITELIST_TARGET_CMDLINE         // /proc/[pid]/cmdline con los argumentos separados por espacios
+} WhitelistTarget;
+
+typedef enum {
+    WHITELIST_MATCH_EXACT = 0,
+    WHITELIST_MATCH_PREFIX,          // "texto*": comparación de prefijo sin fnmatch()
+    WHITELIST_MATCH_GLOB             // Cualquier otro patrón con * ? o [...]
+} WhitelistMatchKind;
+
+/**
+ * Patrón precompilado. Los nombres exactos no usan esta estructura:
+ * van al conjunto hash.
+ */
+typedef struct {
+    char *pattern;                   // Texto tras el prefijo de destino
+    size_t prefix_len;               // Longitud comparada en WHITELIST_MATCH_PREFIX
+    WhitelistTarget target;
+    WhitelistMatchKind kind;
+} WhitelistPattern;
+
+/**
+ * Veredicto memorizado de un proceso. La clave es (pid, starttime); el
+ * nombre se guarda para recalcular si el proceso cambia de comm con exec().
+ */
+typedef struct {
+    pid_t pid;                       // 0 indica entrada vacía
+    unsigned long starttime;
+    char name[16];
+    int whitelisted;
+} WhitelistVerdict;
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+/**
+ * Compila las entradas de WHITELIST. Descarta la compilación y los
+ * veredictos anteriores.
+ * @param entries: Nombres exactos, patrones glob ("kworker*", "chrom?um") o
+ *                 patrones con destino ("exe:/usr/lib/firefox*", "cmdline:*--type=renderer*")
+ * @param count: Número de entradas
+ * @return int: 0 si es exitoso, -1 si no hay memoria
+ */
+int whitelist_compile(char **entries, int count);
+
+/**
+ * Compara solo el nombre del proceso (conjunto exacto y patrones de nombre)
+ * @return int: 1 si está en la whitelist, 0 si no
+ */
+int whitelist_match_name(const char *name);
+
+/**
+ * Veredicto completo de un proceso, calculado una vez por (pid, starttime).
+ * Solo lee exe o cmdline si hay patrones que los usan y el nombre no bastó.
+ * Seguro para llamarse desde varios hilos.
+ * @param pid_fd: Descriptor de /proc/[pid]
+ * @return int: 1 si está en la whitelist, 0 si no
+ */
+int whitelist_match_process(int pid_fd, pid_t pid, unsigned long starttime, const char *name);
+
+/**
+ * Descarta el veredicto memorizado de un proceso terminado
+ */
+void whitelist_forget(pid_t pid, unsigned long starttime);
+
+/**
+ * Libera los patrones compilados y la caché de veredictos
+ */
+void whitelist_cleanup(void);
+
+#endif // PROCESS_WHITELIST_H
@@ -0,0 +1,47 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <stddef.h>
+
+// ============================================================================
+// ESTRUCTURAS INTERNAS
+// ============================================================================
+
+/**
+ * Cadena internada. Todos los procesos con el mismo nombre comparten una
+ * sola copia; se libera cuando suelta la última referencia.
+ */
+typedef struct {
+    char *str;                       // NULL indica ranura vacía
+    size_t hash;
+    unsigned int refs;
+} PooledString;
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+/**
+ * Devuelve la copia internada de una cadena y toma una referencia.
+ * Dos cadenas iguales internadas dan el mismo puntero, así que se
+ * comparan con ==. No es thread-safe: se usa bajo el mutex del monitor.
+ * @return const char*: Copia estable hasta su último string_pool_release(), o NULL si no hay memoria
+ */
+const char* string_pool_intern(const char *str);
+
+/**
+ * Suelta una referencia tomada con string_pool_intern() (NULL se ignora)
+ */
+void string_pool_release(const char *str);
+
+/**
+ * @return size_t: Cadenas distintas vivas en el pool
+ */
+size_t string_pool_count(void);
+
+/**
+ * Libera todas las cadenas, tengan o no referencias
+ */
+void string_pool_clear(void);
+
+#endif // STRING_POOL_H
@@ -0,0 +1,204 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "cgroup_monitor.h"
+
+// Raíz de la jerarquía unificada: montaje puro o modo híbrido de systemd
+#define CGROUP2_ROOT "/sys/fs/cgroup"
+#define CGROUP2_HYBRID_ROOT "/sys/fs/cgroup/unified"
+
+#define CGROUP_FILE_BUFFER_SIZE 4096
+
+// ============================================================================
+// ESTADO DEL COLECTOR
+// ============================================================================
+
+static CgroupState *cgroups = NULL;
+static int num_cgroups = 0;
+static const char *cgroup_root = NULL;
+
+// ============================================================================
+// FUNCIONES AUXILIARES
+// ============================================================================
+
+/**
+ * Localiza la raíz de cgroup v2 comprobando la presencia de cgroup.controllers
+ * @return const char*: Ruta de la raíz, o NULL si el sistema no tiene cgroup v2
+ */
+static const char* find_cgroup2_root(void) {
+    struct stat st;
+    if (stat(CGROUP2_ROOT "/cgroup.controllers", &st) == 0) return CGROUP2_ROOT;
+    if (stat(CGROUP2_HYBRID_ROOT "/cgroup.controllers", &st) == 0) return CGROUP2_HYBRID_ROOT;
+    return NULL;
+}
+
+static int open_cgroup_dir(const CgroupState *cg) {
+    char full_path[4096];
+    if (cg->path[0] == '/') {
+        snprintf(full_path, sizeof(full_path), "%s", cg->path);
+    } else {
+        snprintf(full_path, sizeof(full_path), "%s/%s", cgroup_root, cg->path);
+    }
+    return open(full_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+}
+
+/**
+ * Lee un archivo del cgroup con una sola llamada a read()
+ * @return ssize_t: Bytes leídos, o -1 si hay error
+ */
+static ssize_t read_cgroup_file(int dir_fd, const char *name, char *buf, size_t buf_size) {
+    int fd = openat(dir_fd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    ssize_t len = read(fd, buf, buf_size - 1);
+    close(fd);
+    if (len < 0) return -1;
+    buf[len] = '\0';
+    return len;
+}
+
+/**
+ * Suma rbytes y wbytes de todos los dispositivos listados en io.stat
+ */
+static unsigned long long parse_io_bytes(const char *buf) {
+    unsigned long long total = 0;
+    const char *p = buf;
+
+    while ((p = strstr(p, "bytes=")) != NULL) {
+        // Solo rbytes= y wbytes=; dbytes (descartes) no es E/S real
+        if (p > buf && (p[-1] == 'r' || p[-1] == 'w')) {
+            total += strtoull(p + 6, NULL, 10);
+        }
+        p += 6;
+    }
+    return total;
+}
+
+/**
+ * Lee las tres métricas de un cgroup y calcula las tasas desde la lectura previa
+ * @return int: 0 si es exitoso, -1 si el cgroup no existe
+ */
+static int sample_cgroup(CgroupState *cg, CgroupSample *out) {
+    char buf[CGROUP_FILE_BUFFER_SIZE];
+
+    if (cg->dir_fd < 0) {
+        cg->dir_fd = open_cgroup_dir(cg);
+        if (cg->dir_fd < 0) return -1;
+        cg->has_prev = 0;
+    }
+
+    // cpu.stat: la línea usage_usec siempre está, aunque el controlador cpu no esté habilitado
+    if (read_cgroup_file(cg->dir_fd, "cpu.stat", buf, sizeof(buf)) < 0) {
+        // El cgroup se eliminó: cerrar para reabrirlo si vuelve a crearse
+        close(cg->dir_fd);
+        cg->dir_fd = -1;
+        return -1;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    unsigned long long usage_usec = 0;
+    char *usage = strstr(buf, "usage_usec ");
+    if (usage) usage_usec = strtoull(usage + 11, NULL, 10);
+
+    // memory.current e io.stat requieren sus controladores; si faltan se reporta 0
+    unsigned long long memory_bytes = 0;
+    if (read_cgroup_file(cg->dir_fd, "memory.current", buf, sizeof(buf)) > 0) {
+        memory_bytes = strtoull(buf, NULL, 10);
+    }
+
+    unsigned long long io_bytes = 0;
+    if (read_cgroup_file(cg->dir_fd, "io.stat", buf, sizeof(buf)) >= 0) {
+        io_bytes = parse_io_bytes(buf);
+    }
+
+    out->path = cg->path;
+    out->memory_kb = (unsigned long)(memory_bytes / 1024);
+    out->cpu_usage = 0.0f;
+    out->io_kbps = 0.0f;
+    out->valid = 1;
+
+    if (cg->has_prev) {
+        double elapsed = (now.tv_sec - cg->prev_timestamp.tv_sec) +
+                         (now.tv_nsec - cg->prev_timestamp.tv_nsec) / 1e9;
+        if (elapsed > 0.0) {
+            if (usage_usec >= cg->prev_usage_usec) {
+                out->cpu_usage = (float)(100.0 * (usage_usec - cg->prev_usage_usec) / 1e6 / elapsed);
+            }
+            if (io_bytes >= cg->prev_io_bytes) {
+                out->io_kbps = (float)((io_bytes - cg->prev_io_bytes) / 1024.0 / elapsed);
+            }
+        }
+    }
+
+    cg->prev_usage_usec = usage_usec;
+    cg->prev_io_bytes = io_bytes;
+    cg->prev_timestamp = now;
+    cg->has_prev = 1;
+    return 0;
+}
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+int cgroup_monitor_configure(char **paths, int count) {
+    cgroup_monitor_cleanup();
+    if (count <= 0) return 0;
+
+    cgroup_root = find_cgroup2_root();
+    if (!cgroup_root) {
+        fprintf(stderr, "[WARNING] No se encontró una jerarquía cgroup v2; "
+                "se omite el monitoreo de cgroups\n");
+        return -1;
+    }
+
+    cgroups = calloc((size_t)count, sizeof(CgroupState));
+    if (!cgroups) {
+        fprintf(stderr, "[ERROR] No se pudo asignar memoria para los cgroups\n");
+        return -1;
+    }
+
+    // Todo o nada: el llamador asocia la entrada i con paths[i]
+    for (int i = 0; i < count; i++) {
+        cgroups[i].dir_fd = -1;
+        cgroups[i].path = strdup(paths[i]);
+        num_cgroups++;
+        if (!cgroups[i].path) {
+            fprintf(stderr, "[ERROR] No se pudo duplicar la ruta del cgroup\n");
+            cgroup_monitor_cleanup();
+            return -1;
+        }
+    }
+
+    printf("[INFO] Monitoreo de %d cgroup(s) bajo %s\n", num_cgroups, cgroup_root);
+    return 0;
+}
+
+int cgroup_monitor_sample(CgroupSample *out) {
+    for (int i = 0; i < num_cgroups; i++) {
+        if (sample_cgroup(&cgroups[i], &out[i]) != 0) {
+            memset(&out[i], 0, sizeof(CgroupSample));
+            out[i].path = cgroups[i].path;
+        }
+    }
+    return num_cgroups;
+}
+
+int cgroup_monitor_count(void) {
+    return num_cgroups;
+}
+
+void cgroup_monitor_cleanup(void) {
+    for (int i = 0; i < num_cgroups; i++) {
+        if (cgroups[i].dir_fd >= 0) close(cgroups[i].dir_fd);
+        free(cgroups[i].path);
+    }
+    free(cgroups);
+    cgroups = NULL;
+    num_cgroups = 0;
+}
@@ -1,5 +1,9 @@
 #define _GNU_SOURCE  // Para strdup y strnlen
 #include <device_monitor.h>
+#include <pressure_monitor.h>
+
+// Pausa total por presión del sistema que puede acumular un escaneo
+#define SCAN_THROTTLE_BUDGET_MS 30000
 
 // ============================================================================
 // FUNCIONES DE MONITOREO DE DISPOSITIVOS
@@ -175,13 +179,13 @@ char* get_file_extension(const char *filename) {
 }
 
 /**
- * Escanea recursivamente un directorio y almacena información de archivos
+ * Recorrido de scan_directory_recursive() con el presupuesto de pausas
+ * compartido por todos los niveles del escaneo
  * 
- * @param snapshot: Puntero al snapshot donde almacenar la información
- * @param dir_path: Ruta del directorio a escanear
+ * @param throttle_budget_ms: Pausa por presión que aún puede gastar el escaneo
  * @return int: 0 si es exitoso, -1 si hay error
  */
-int scan_directory_recursive(DeviceSnapshot *snapshot, const char *dir_path) {
+static int scan_directory_budgeted(DeviceSnapshot *snapshot, const char *dir_path, int *throttle_budget_ms) {
     DIR *dir = opendir(dir_path);
     if (!dir) {
         return -1;
@@ -205,7 +209,7 @@ int scan_directory_recursive(DeviceSnapshot *snapshot, const char *dir_path) {
         
         if (S_ISDIR(file_stat.st_mode)) {
             // Es un directorio, escanear recursivamente
-            scan_directory_recursive(snapshot, full_path);
+            scan_directory_budgeted(snapshot, full_path, throttle_budget_ms);
         } else if (S_ISREG(file_stat.st_mode)) {
             // Es un archivo regular, almacenar información
             
@@ -228,7 +232,10 @@ int scan_directory_recursive(DeviceSnapshot *snapshot, const char *dir_path) {
             file_info->last_modified = file_stat.st_mtime;
             file_info->last_accessed = file_stat.st_atime;
             
-            // Calcular hash SHA-256
+            // Calcular hash SHA-256; con el sistema bajo presión se espera
+            // antes de leer el archivo para no agravar la contención, hasta
+            // agotar el presupuesto del escaneo
+            pressure_throttle_point(throttle_budget_ms, NULL);
             if (calculate_sha256(full_path, file_info->sha256_hash) != 0) {
                 strcpy(file_info->sha256_hash, "ERROR_CALCULATING_HASH");
             }
@@ -246,6 +253,18 @@ int scan_directory_recursive(DeviceSnapshot *snapshot, const char *dir_path) {
     return 0;
 }
 
+/**
+ * Escanea recursivamente un directorio y almacena información de archivos
+ * 
+ * @param snapshot: Puntero al snapshot donde almacenar la información
+ * @param dir_path: Ruta del directorio a escanear
+ * @return int: 0 si es exitoso, -1 si hay error
+ */
+int scan_directory_recursive(DeviceSnapshot *snapshot, const char *dir_path) {
+    int throttle_budget_ms = SCAN_THROTTLE_BUDGET_MS;
+    return scan_directory_budgeted(snapshot, dir_path, &throttle_budget_ms);
+}
+
 /**
  * Crea un snapshot completo de un dispositivo
  * 
@@ -312,8 +331,16 @@ DeviceSnapshot* create_device_snapshot(const char *device_name) {
     printf("Creando snapshot del dispositivo: %s\n", device_name);
     printf("Escaneando directorio: %s\n", device_path);
     
-    // Escanear el dispositivo
-    if (scan_directory_recursive(snapshot, device_path) != 0) {
+    LoadLevel load_level = pressure_get_level();
+    if (load_level != LOAD_LEVEL_NORMAL) {
+        printf("[INFO] Presión del sistema %s: el escaneo se hará con pausas (máximo %d s en total)\n",
+               pressure_level_name(load_level), SCAN_THROTTLE_BUDGET_MS / 1000);
+    }
+    
+    // Escanear el dispositivo; las pausas por presión de todo el árbol
+    // comparten un solo presupuesto
+    int throttle_budget_ms = SCAN_THROTTLE_BUDGET_MS;
+    if (scan_directory_budgeted(snapshot, device_path, &throttle_budget_ms) != 0) {
         printf("Error al escanear el dispositivo %s\n", device_name);
     }
     
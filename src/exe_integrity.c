@@ -0,0 +1,302 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "exe_integrity.h"
+#include "device_monitor.h"
+#include "pressure_monitor.h"
+
+#define EXE_CACHE_INITIAL_CAPACITY 256
+#define EXE_CACHE_MAX_CAPACITY 8192      // Al llenarse se vacía: se rehashea solo lo que siga en uso
+#define EXE_HASH_QUEUE_SIZE 64           // Trabajos en espera; si la cola está llena se reintenta después
+#define EXE_HASH_PAUSE_MS 20             // Pausa entre dos hashes para no competir con el muestreo
+
+#define MEMFD_PREFIX "/memfd:"
+#define DELETED_SUFFIX " (deleted)"
+
+// ============================================================================
+// ESTADO DEL MÓDULO
+// ============================================================================
+
+static ExeCacheEntry *exe_cache = NULL;
+static size_t exe_cache_capacity = 0;
+static size_t exe_cache_count = 0;
+
+// Cola circular de trabajos para el hilo de hashing
+static ExeHashJob hash_queue[EXE_HASH_QUEUE_SIZE];
+static int queue_head = 0;
+static int queue_count = 0;
+
+static pthread_t hash_thread;
+static volatile int hash_running = 0;
+static unsigned long max_hash_kb = 0;
+
+// Protege la caché y la cola; el hilo de hashing no lo sostiene mientras lee
+static pthread_mutex_t exe_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_ready = PTHREAD_COND_INITIALIZER;
+
+// ============================================================================
+// FUNCIONES AUXILIARES
+// ============================================================================
+
+static size_t exe_key_hash(const ExeKey *key) {
+    unsigned long long h = (unsigned long long)key->ino * 0x9e3779b97f4a7c15ULL;
+    h ^= (unsigned long long)key->dev + 0x9e3779b9ULL + (h << 6) + (h >> 2);
+    h ^= (unsigned long long)key->mtime.tv_sec + (h << 6) + (h >> 2);
+    return (size_t)h;
+}
+
+static int exe_key_equal(const ExeKey *a, const ExeKey *b) {
+    return a->dev == b->dev && a->ino == b->ino && a->size == b->size &&
+           a->mtime.tv_sec == b->mtime.tv_sec && a->mtime.tv_nsec == b->mtime.tv_nsec;
+}
+
+static void exe_key_from_stat(const struct stat *st, ExeKey *key) {
+    memset(key, 0, sizeof(ExeKey));
+    key->dev = st->st_dev;
+    key->ino = st->st_ino;
+    key->mtime = st->st_mtim;
+    key->size = st->st_size;
+}
+
+static ExeCacheEntry* cache_find(const ExeKey *key) {
+    if (!exe_cache) return NULL;
+    size_t mask = exe_cache_capacity - 1;
+    for (size_t pos = exe_key_hash(key) & mask; exe_cache[pos].used; pos = (pos + 1) & mask) {
+        if (exe_key_equal(&exe_cache[pos].key, key)) return &exe_cache[pos];
+    }
+    return NULL;
+}
+
+static int cache_grow(void) {
+    size_t new_capacity = exe_cache_capacity ? exe_cache_capacity * 2 : EXE_CACHE_INITIAL_CAPACITY;
+
+    if (new_capacity > EXE_CACHE_MAX_CAPACITY) {
+        // Tope alcanzado: vaciar en lugar de crecer sin límite
+        memset(exe_cache, 0, exe_cache_capacity * sizeof(ExeCacheEntry));
+        exe_cache_count = 0;
+        return 0;
+    }
+
+    ExeCacheEntry *new_cache = calloc(new_capacity, sizeof(ExeCacheEntry));
+    if (!new_cache) return -1;
+
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < exe_cache_capacity; i++) {
+        if (!exe_cache[i].used) continue;
+        size_t pos = exe_key_hash(&exe_cache[i].key) & mask;
+        while (new_cache[pos].used) pos = (pos + 1) & mask;
+        new_cache[pos] = exe_cache[i];
+    }
+
+    free(exe_cache);
+    exe_cache = new_cache;
+    exe_cache_capacity = new_capacity;
+    return 0;
+}
+
+static ExeCacheEntry* cache_insert(const ExeKey *key) {
+    if ((exe_cache_count + 1) * 4 > exe_cache_capacity * 3 && cache_grow() != 0) {
+        return NULL;
+    }
+
+    size_t mask = exe_cache_capacity - 1;
+    size_t pos = exe_key_hash(key) & mask;
+    while (exe_cache[pos].used) pos = (pos + 1) & mask;
+
+    memset(&exe_cache[pos], 0, sizeof(ExeCacheEntry));
+    exe_cache[pos].key = *key;
+    exe_cache[pos].state = EXE_HASH_PENDING;
+    exe_cache[pos].used = 1;
+    exe_cache_count++;
+    return &exe_cache[pos];
+}
+
+/**
+ * Encola el cálculo del hash de una entrada pendiente (requiere exe_mutex)
+ */
+static void enqueue_hash_job(ExeCacheEntry *entry, pid_t pid) {
+    if (entry->queued || !hash_running || queue_count >= EXE_HASH_QUEUE_SIZE) return;
+
+    ExeHashJob *job = &hash_queue[(queue_head + queue_count) % EXE_HASH_QUEUE_SIZE];
+    job->pid = pid;
+    job->key = entry->key;
+    queue_count++;
+    entry->queued = 1;
+    pthread_cond_signal(&queue_ready);
+}
+
+/**
+ * Calcula el hash de un trabajo. El binario se abre por /proc/[pid]/exe, que
+ * sigue accesible aunque se haya borrado del disco o sea un memfd, y se
+ * comprueba que el descriptor corresponda a la clave encolada por si el
+ * proceso terminó o hizo exec mientras esperaba.
+ */
+static void run_hash_job(const ExeHashJob *job) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/exe", job->pid);
+
+    ExeHashState state = EXE_HASH_SKIPPED;
+    char sha256[65] = "";
+    int stale = 0;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        stale = 1;
+    } else {
+        ExeKey key;
+        exe_key_from_stat(&st, &key);
+        if (!exe_key_equal(&key, &job->key)) {
+            stale = 1;
+        } else if (max_hash_kb == 0 || (unsigned long)(st.st_size / 1024) <= max_hash_kb) {
+            // calculate_sha256() recibe una ruta: se reabre el mismo archivo por el descriptor
+            char fd_path[64];
+            snprintf(fd_path, sizeof(fd_path), "/proc/self/fd/%d", fd);
+            if (calculate_sha256(fd_path, sha256) == 0) {
+                state = EXE_HASH_DONE;
+            }
+        }
+    }
+    if (fd >= 0) close(fd);
+
+    pthread_mutex_lock(&exe_mutex);
+    ExeCacheEntry *entry = cache_find(&job->key);
+    if (entry) {
+        entry->queued = 0;
+        // Un trabajo obsoleto deja la entrada pendiente: la próxima consulta la reencola
+        if (!stale) {
+            entry->state = state;
+            memcpy(entry->sha256, sha256, sizeof(entry->sha256));
+        }
+    }
+    pthread_mutex_unlock(&exe_mutex);
+}
+
+static void* exe_hash_thread(void *arg) {
+    (void)arg;
+
+    pthread_mutex_lock(&exe_mutex);
+    while (hash_running) {
+        if (queue_count == 0) {
+            pthread_cond_wait(&queue_ready, &exe_mutex);
+            continue;
+        }
+
+        ExeHashJob job = hash_queue[queue_head];
+        queue_head = (queue_head + 1) % EXE_HASH_QUEUE_SIZE;
+        queue_count--;
+        pthread_mutex_unlock(&exe_mutex);
+
+        run_hash_job(&job);
+        usleep(EXE_HASH_PAUSE_MS * 1000);
+        // Con el sistema bajo presión el siguiente hash espera, salvo que
+        // exe_integrity_stop() pida terminar
+        pressure_throttle_point(NULL, &hash_running);
+
+        pthread_mutex_lock(&exe_mutex);
+    }
+    pthread_mutex_unlock(&exe_mutex);
+    return NULL;
+}
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+int exe_integrity_start(unsigned long max_file_kb) {
+    pthread_mutex_lock(&exe_mutex);
+    if (hash_running) {
+        pthread_mutex_unlock(&exe_mutex);
+        return 1;
+    }
+    max_hash_kb = max_file_kb;
+    queue_head = 0;
+    queue_count = 0;
+    hash_running = 1;
+    pthread_mutex_unlock(&exe_mutex);
+
+    int result = pthread_create(&hash_thread, NULL, exe_hash_thread, NULL);
+    if (result != 0) {
+        hash_running = 0;
+        fprintf(stderr, "[ERROR] No se pudo crear el hilo de integridad de ejecutables: %d\n", result);
+        return -1;
+    }
+
+    printf("[INFO] Verificación de integridad de ejecutables activada\n");
+    return 0;
+}
+
+void exe_integrity_stop(void) {
+    pthread_mutex_lock(&exe_mutex);
+    int was_running = hash_running;
+    hash_running = 0;
+    pthread_cond_signal(&queue_ready);
+    pthread_mutex_unlock(&exe_mutex);
+
+    if (was_running) {
+        pthread_join(hash_thread, NULL);
+    }
+
+    pthread_mutex_lock(&exe_mutex);
+    free(exe_cache);
+    exe_cache = NULL;
+    exe_cache_capacity = 0;
+    exe_cache_count = 0;
+    queue_head = 0;
+    queue_count = 0;
+    pthread_mutex_unlock(&exe_mutex);
+}
+
+int exe_integrity_check(pid_t pid, ExeIntegrity *out) {
+    char path[64];
+    char target[512];
+    snprintf(path, sizeof(path), "/proc/%d/exe", pid);
+
+    // Los hilos del kernel no tienen ejecutable y readlink() falla
+    ssize_t len = readlink(path, target, sizeof(target) - 1);
+    if (len < 0) return -1;
+    target[len] = '\0';
+
+    memset(out, 0, sizeof(ExeIntegrity));
+    if (strncmp(target, MEMFD_PREFIX, strlen(MEMFD_PREFIX)) == 0) {
+        out->flags |= EXE_FLAG_MEMFD;
+    } else if ((size_t)len > strlen(DELETED_SUFFIX) &&
+               strcmp(target + len - strlen(DELETED_SUFFIX), DELETED_SUFFIX) == 0) {
+        out->flags |= EXE_FLAG_DELETED;
+    }
+
+    // stat() sigue el enlace al archivo real, aunque ya no tenga nombre en disco
+    struct stat st;
+    if (stat(path, &st) != 0) return -1;
+    ExeKey key;
+    exe_key_from_stat(&st, &key);
+
+    pthread_mutex_lock(&exe_mutex);
+    ExeCacheEntry *entry = cache_find(&key);
+    if (!entry) {
+        entry = cache_insert(&key);
+    }
+    if (!entry) {
+        pthread_mutex_unlock(&exe_mutex);
+        out->state = EXE_HASH_SKIPPED;
+        return 0;
+    }
+
+    out->state = entry->state;
+    if (entry->state == EXE_HASH_PENDING) {
+        if (hash_running) {
+            enqueue_hash_job(entry, pid);
+        } else {
+            // Sin hilo de hashing no se calcula: no dejar al llamador esperando
+            out->state = EXE_HASH_SKIPPED;
+        }
+    }
+    memcpy(out->sha256, entry->sha256, sizeof(out->sha256));
+    pthread_mutex_unlock(&exe_mutex);
+    return 0;
+}
@@ -71,9 +71,9 @@ int adapt_process_info_to_gui(const ProcessInfo *backend_info, GUIProcess *gui_p
         gui_process->is_suspicious = FALSE;
     } else {
         // Solo para procesos NO whitelisted, aplicar detección de comportamiento sospechoso
-        if (backend_info->alerta_activa) {
+        if (backend_info->state.alerta_activa) {
             gui_process->is_suspicious = TRUE;
-        } else if (backend_info->exceeds_thresholds) {
+        } else if (backend_info->state.exceeds_thresholds) {
             gui_process->is_suspicious = TRUE;
         } else if (backend_info->cpu_usage > 95.0 || backend_info->mem_usage > 90.0) {
             gui_process->is_suspicious = TRUE;
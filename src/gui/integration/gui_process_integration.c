@@ -42,11 +42,18 @@ int init_process_integration(void) {
     // Paso 2: Configurar callbacks que conectan eventos del backend con la GUI
     // Estos callbacks actúan como "traductores" que convierten eventos
     // orientados a datos del backend en actualizaciones de la interfaz gráfica
-    backend_callbacks.on_new_process = on_gui_process_new;
-    backend_callbacks.on_process_terminated = on_gui_process_terminated;
+    // Altas y bajas llegan agrupadas en un diff por ciclo: una sola entrada
+    // de log y una sola actualización de estadísticas por entrega
+    backend_callbacks.on_cycle_delta = on_gui_cycle_delta;
     backend_callbacks.on_high_cpu_alert = on_gui_high_cpu_alert;
     backend_callbacks.on_high_memory_alert = on_gui_high_memory_alert;
     backend_callbacks.on_alert_cleared = on_gui_alert_cleared;
+    backend_callbacks.on_high_io_alert = on_gui_high_io_alert;
+    backend_callbacks.on_subtree_alert = on_gui_subtree_alert;
+    backend_callbacks.on_memory_growth_alert = on_gui_memory_growth_alert;
+    backend_callbacks.on_executable_alert = on_gui_executable_alert;
+    backend_callbacks.on_pressure_alert = on_gui_pressure_alert;
+    backend_callbacks.on_pressure_cleared = on_gui_pressure_cleared;
     
     // Paso 3: Registrar los callbacks en el backend
     // Esta llamada le dice al sistema de monitoreo qué funciones debe
@@ -220,6 +227,57 @@ void on_gui_process_terminated(pid_t pid, const char *name) {
     }
 }
 
+void on_gui_cycle_delta(const ProcessDelta *delta) {
+    if (!delta) return;
+
+    // Paso 1: Reflejar en la vista los procesos nuevos y los que cambiaron
+    GUIProcess gui_process;
+    for (int i = 0; i < delta->num_added; i++) {
+        if (adapt_process_info_to_gui(&delta->added[i].info, &gui_process) == 0) {
+            gui_update_process(&gui_process);
+        }
+    }
+    for (int i = 0; i < delta->num_changed; i++) {
+        if (adapt_process_info_to_gui(&delta->changed[i].info, &gui_process) == 0) {
+            gui_update_process(&gui_process);
+        }
+    }
+
+    // Paso 2: Una entrada de log que resume las altas y bajas de la entrega
+    if (delta->num_added > 0 || delta->num_removed > 0) {
+        char log_msg[512];
+        if (delta->num_added == 1 && delta->num_removed == 0) {
+            const ProcessInfo *info = &delta->added[0].info;
+            snprintf(log_msg, sizeof(log_msg),
+                     "Nuevo proceso detectado: %s (PID: %d) - CPU: %.1f%%, MEM: %.1f%%",
+                     info->name, info->pid, info->cpu_usage, info->mem_usage);
+        } else if (delta->num_added == 0 && delta->num_removed == 1) {
+            const ProcessInfo *info = &delta->removed[0].info;
+            snprintf(log_msg, sizeof(log_msg), "Proceso terminado: %s (PID: %d)",
+                     info->name, info->pid);
+        } else {
+            snprintf(log_msg, sizeof(log_msg), "%d procesos nuevos, %d terminados",
+                     delta->num_added, delta->num_removed);
+        }
+        gui_add_log_entry("PROCESS_MONITOR", "INFO", log_msg);
+
+        // Paso 3: Estadísticas una sola vez por entrega
+        int total, high_cpu, high_mem;
+        if (get_process_statistics_for_gui(&total, &high_cpu, &high_mem) == 0) {
+            gui_update_statistics(0, total, 0);
+        }
+    }
+    
+    // Paso 4: Las alertas retenidas por el límite llegan como un solo resumen
+    if (delta->num_alerts_suppressed > 0) {
+        char log_msg[256];
+        snprintf(log_msg, sizeof(log_msg),
+                 "%d alertas retenidas por enfriamiento o por el límite de notificaciones",
+                 delta->num_alerts_suppressed);
+        gui_add_log_entry("PROCESS_MONITOR", "WARNING", log_msg);
+    }
+}
+
 void on_gui_high_cpu_alert(ProcessInfo *info) {
     if (!info) return;
     
@@ -249,6 +307,14 @@ void on_gui_high_cpu_alert(ProcessInfo *info) {
              info->name, info->pid, info->cpu_usage);
     gui_add_log_entry("PROCESS_MONITOR", "ALERT", log_msg);
     
+    // En modo por tareas, indicar qué hilos concentran el consumo
+    for (int i = 0; i < info->num_hot_threads; i++) {
+        snprintf(log_msg, sizeof(log_msg), 
+                 "   ↳ Hilo '%s' (TID: %d) usando %.1f%% de CPU", 
+                 info->hot_threads[i].name, info->hot_threads[i].tid, info->hot_threads[i].cpu_usage);
+        gui_add_log_entry("PROCESS_MONITOR", "ALERT", log_msg);
+    }
+    
     // Si las notificaciones están habilitadas, podríamos disparar
     // una notificación del sistema aquí usando is_notifications_enabled()
 }
@@ -280,6 +346,111 @@ void on_gui_high_memory_alert(ProcessInfo *info) {
     gui_add_log_entry("PROCESS_MONITOR", "ALERT", log_msg);
 }
 
+void on_gui_high_io_alert(ProcessInfo *info) {
+    if (!info) return;
+    
+    // Los procesos en whitelist no generan alertas de E/S
+    if (info->is_whitelisted) {
+        char debug_msg[256];
+        snprintf(debug_msg, sizeof(debug_msg), 
+                 "⚠️ ADVERTENCIA: Intento de alerta E/S para proceso whitelisted '%s' (PID: %d)", 
+                 info->name, info->pid);
+        gui_add_log_entry("PROCESS_MONITOR", "WARNING", debug_msg);
+        return;
+    }
+    
+    GUIProcess gui_process;
+    if (adapt_process_info_to_gui(info, &gui_process) != 0) {
+        return;
+    }
+    
+    gui_update_process(&gui_process);
+    
+    char log_msg[512];
+    snprintf(log_msg, sizeof(log_msg), 
+             "🚨 ALERTA E/S: Proceso '%s' (PID: %d) leyendo %.1f kB/s y escribiendo %.1f kB/s (%.0f/%.0f llamadas/s)", 
+             info->name, info->pid, info->io_read_kbps, info->io_write_kbps,
+             info->syscr_rate, info->syscw_rate);
+    gui_add_log_entry("PROCESS_MONITOR", "ALERT", log_msg);
+}
+
+void on_gui_subtree_alert(ProcessInfo *root) {
+    if (!root) return;
+    
+    GUIProcess gui_process;
+    if (adapt_process_info_to_gui(root, &gui_process) != 0) {
+        return;
+    }
+    
+    gui_update_process(&gui_process);
+    
+    char log_msg[512];
+    snprintf(log_msg, sizeof(log_msg), 
+             "🚨 ALERTA SUBÁRBOL: Proceso '%s' (PID: %d) y sus %d descendientes usan %.1f%% de CPU y %.1f%% de RAM", 
+             root->name, root->pid, root->state.subtree_processes - 1,
+             root->state.subtree_cpu_usage, root->state.subtree_mem_usage);
+    gui_add_log_entry("PROCESS_MONITOR", "ALERT", log_msg);
+}
+
+void on_gui_memory_growth_alert(ProcessInfo *info) {
+    if (!info || info->is_whitelisted) return;
+    
+    GUIProcess gui_process;
+    if (adapt_process_info_to_gui(info, &gui_process) != 0) {
+        return;
+    }
+    
+    gui_update_process(&gui_process);
+    
+    char log_msg[512];
+    snprintf(log_msg, sizeof(log_msg), 
+             "🚨 POSIBLE FUGA DE MEMORIA: Proceso '%s' (PID: %d) crece %.1f kB/s de forma sostenida (R²: %.2f, RSS: %lu kB)", 
+             info->name, info->pid, info->state.mem_growth_kbps, info->state.mem_growth_r2, info->rss_kb);
+    gui_add_log_entry("PROCESS_MONITOR", "ALERT", log_msg);
+}
+
+void on_gui_executable_alert(ProcessInfo *info) {
+    if (!info || info->is_whitelisted) return;
+    
+    GUIProcess gui_process;
+    if (adapt_process_info_to_gui(info, &gui_process) != 0) {
+        return;
+    }
+    
+    gui_update_process(&gui_process);
+    
+    char log_msg[512];
+    snprintf(log_msg, sizeof(log_msg), 
+             "🚨 EJECUTABLE SOSPECHOSO: Proceso '%s' (PID: %d) ejecuta un %s", 
+             info->name, info->pid,
+             (info->state.exe_flags & EXE_FLAG_MEMFD) ? "binario que solo existe en memoria (memfd)" :
+                                                  "binario borrado del disco");
+    gui_add_log_entry("PROCESS_MONITOR", "ALERT", log_msg);
+}
+
+void on_gui_pressure_alert(const SystemPressure *pressure, PsiResource resource) {
+    if (!pressure) return;
+    
+    const PsiStats *stats = &pressure->resources[resource];
+    char log_msg[512];
+    snprintf(log_msg, sizeof(log_msg), 
+             "🌡️ SISTEMA SATURADO: presión de %s sostenida (some avg10: %.1f%%, full avg10: %.1f%%). "
+             "Monitoreo autorregulado en nivel %s", 
+             pressure_resource_name(resource), stats->some.avg10, stats->full.avg10,
+             pressure_level_name(pressure->level));
+    gui_add_log_entry("SYSTEM_PRESSURE", "ALERT", log_msg);
+}
+
+void on_gui_pressure_cleared(const SystemPressure *pressure, PsiResource resource) {
+    if (!pressure) return;
+    
+    char log_msg[256];
+    snprintf(log_msg, sizeof(log_msg), 
+             "✅ Presión de %s normalizada (some avg10: %.1f%%)", 
+             pressure_resource_name(resource), pressure->resources[resource].some.avg10);
+    gui_add_log_entry("SYSTEM_PRESSURE", "INFO", log_msg);
+}
+
 void on_gui_alert_cleared(ProcessInfo *info) {
     if (!info) return;
     
@@ -0,0 +1,79 @@
+#define _GNU_SOURCE
+#include <string.h>
+#include "memory_trend.h"
+
+// Muestras mínimas para que el R² de la recta signifique algo
+#define TREND_MIN_SAMPLES 3
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+void memory_trend_reset(MemoryTrend *trend) {
+    memset(trend, 0, sizeof(MemoryTrend));
+}
+
+void memory_trend_add(MemoryTrend *trend, const struct timespec *now,
+                      unsigned long rss_kb, double window_seconds) {
+    if (trend->samples == 0) {
+        memory_trend_reset(trend);
+        trend->weight = 1.0;
+        trend->samples = 1;
+        trend->last_rss_kb = rss_kb;
+        trend->last = *now;
+        trend->since = *now;
+        return;
+    }
+    
+    double dt = (now->tv_sec - trend->last.tv_sec) + (now->tv_nsec - trend->last.tv_nsec) / 1e9;
+    if (dt <= 0.0) return;
+    double dy = (double)rss_kb - (double)trend->last_rss_kb;
+    
+    // Olvido: w / (w + dt) aproxima exp(-dt / w) sin depender de libm
+    double decay = window_seconds > 0.0 ? window_seconds / (window_seconds + dt) : 1.0;
+    double w = trend->weight * decay;
+    double st = trend->sum_t * decay;
+    double stt = trend->sum_tt * decay;
+    double sy = trend->sum_y * decay;
+    double syy = trend->sum_yy * decay;
+    double sty = trend->sum_ty * decay;
+    
+    // Mover el origen a la muestra nueva: t' = t - dt, y' = y - dy
+    trend->sum_tt = stt - 2.0 * dt * st + w * dt * dt;
+    trend->sum_yy = syy - 2.0 * dy * sy + w * dy * dy;
+    trend->sum_ty = sty - dy * st - dt * sy + w * dt * dy;
+    trend->sum_t = st - w * dt;
+    trend->sum_y = sy - w * dy;
+    
+    // La muestra nueva está en el origen: solo aporta su peso
+    trend->weight = w + 1.0;
+    trend->samples++;
+    trend->last_step_kbps = dy / dt;
+    trend->last_rss_kb = rss_kb;
+    trend->last = *now;
+}
+
+int memory_trend_fit(const MemoryTrend *trend, double *slope_kbps, double *r2) {
+    if (trend->samples < TREND_MIN_SAMPLES) return -1;
+    
+    double w = trend->weight;
+    double mean_t = trend->sum_t / w;
+    double mean_y = trend->sum_y / w;
+    double var_t = trend->sum_tt / w - mean_t * mean_t;
+    double var_y = trend->sum_yy / w - mean_y * mean_y;
+    double cov = trend->sum_ty / w - mean_t * mean_y;
+    
+    if (var_t <= 0.0) return -1;
+    
+    *slope_kbps = cov / var_t;
+    // Serie constante: la recta no explica nada porque no hay nada que explicar
+    *r2 = var_y > 0.0 ? (cov * cov) / (var_t * var_y) : 0.0;
+    if (*r2 > 1.0) *r2 = 1.0;
+    return 0;
+}
+
+double memory_trend_span(const MemoryTrend *trend) {
+    if (trend->samples == 0) return 0.0;
+    return (trend->last.tv_sec - trend->since.tv_sec) +
+           (trend->last.tv_nsec - trend->since.tv_nsec) / 1e9;
+}
@@ -0,0 +1,224 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "pressure_monitor.h"
+
+#define PSI_REFRESH_MS 1000              // Antigüedad máxima de la lectura en pressure_get_level()
+#define PSI_ELEVATED_PAUSE_MS 20         // Pausa que cede un trabajo largo con presión elevada
+#define PSI_CRITICAL_POLL_MS 100         // Cada cuánto se revisa si bajó la presión crítica
+#define PSI_CRITICAL_MAX_PAUSE_MS 2000   // Espera máxima por punto de pausa con presión crítica
+
+// Valores por defecto, los mismos que carga load_config() sin archivo
+#define PSI_DEFAULT_ELEVATED 25.0f
+#define PSI_DEFAULT_CRITICAL 60.0f
+#define PSI_DEFAULT_HYSTERESIS 0.9f
+
+static const char *psi_paths[PSI_RESOURCE_COUNT] = {
+    "/proc/pressure/cpu",
+    "/proc/pressure/memory",
+    "/proc/pressure/io"
+};
+
+// ============================================================================
+// ESTADO DEL MÓDULO
+// ============================================================================
+
+static SystemPressure last_pressure;
+static int has_reading = 0;
+static float elevated_threshold = PSI_DEFAULT_ELEVATED;
+static float critical_threshold = PSI_DEFAULT_CRITICAL;
+static float level_hysteresis = PSI_DEFAULT_HYSTERESIS;
+
+// Protege la última lectura y los umbrales: la consultan el hilo de
+// monitoreo, el de hashing y los escaneos de dispositivos
+static pthread_mutex_t pressure_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// ============================================================================
+// FUNCIONES AUXILIARES
+// ============================================================================
+
+static int read_psi_file(const char *path, PsiStats *stats) {
+    memset(stats, 0, sizeof(PsiStats));
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) return -1;
+
+    char line[256];
+    int lines = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        PsiLine *target = NULL;
+        if (strncmp(line, "some ", 5) == 0) {
+            target = &stats->some;
+        } else if (strncmp(line, "full ", 5) == 0) {
+            target = &stats->full;
+        }
+        if (target && sscanf(line + 5, "avg10=%f avg60=%f avg300=%f total=%llu",
+                             &target->avg10, &target->avg60, &target->avg300,
+                             &target->total_us) == 4) {
+            lines++;
+        }
+    }
+    fclose(fp);
+
+    // Con psi=0 en la línea de comandos el archivo existe pero read() falla
+    if (lines == 0) return -1;
+    stats->available = 1;
+    return 0;
+}
+
+/**
+ * Sube de nivel en cuanto el pico cruza un umbral y solo baja cuando queda
+ * por debajo de la banda de histéresis, para no oscilar en el borde
+ * (requiere pressure_mutex)
+ */
+static LoadLevel next_level(LoadLevel current, float peak) {
+    if (elevated_threshold <= 0.0f) return LOAD_LEVEL_NORMAL;
+
+    if (critical_threshold > 0.0f && peak >= critical_threshold) return LOAD_LEVEL_CRITICAL;
+    if (current == LOAD_LEVEL_CRITICAL && critical_threshold > 0.0f &&
+        peak >= critical_threshold * level_hysteresis) {
+        return LOAD_LEVEL_CRITICAL;
+    }
+
+    if (peak >= elevated_threshold) return LOAD_LEVEL_ELEVATED;
+    if (current != LOAD_LEVEL_NORMAL && peak >= elevated_threshold * level_hysteresis) {
+        return LOAD_LEVEL_ELEVATED;
+    }
+    return LOAD_LEVEL_NORMAL;
+}
+
+/**
+ * Lee los tres recursos y actualiza last_pressure (requiere pressure_mutex)
+ */
+static int refresh_pressure_locked(void) {
+    SystemPressure reading;
+    memset(&reading, 0, sizeof(SystemPressure));
+
+    int available = 0;
+    for (int r = 0; r < PSI_RESOURCE_COUNT; r++) {
+        if (read_psi_file(psi_paths[r], &reading.resources[r]) == 0) {
+            available++;
+            if (reading.resources[r].some.avg10 > reading.peak_avg10) {
+                reading.peak_avg10 = reading.resources[r].some.avg10;
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &reading.taken);
+
+    LoadLevel current = has_reading ? last_pressure.level : LOAD_LEVEL_NORMAL;
+    reading.level = available > 0 ? next_level(current, reading.peak_avg10) : LOAD_LEVEL_NORMAL;
+
+    last_pressure = reading;
+    has_reading = 1;
+    return available > 0 ? 0 : -1;
+}
+
+static long elapsed_ms(const struct timespec *since) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - since->tv_sec) * 1000L + (now.tv_nsec - since->tv_nsec) / 1000000L;
+}
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+void pressure_configure(float elevated, float critical, float hysteresis) {
+    pthread_mutex_lock(&pressure_mutex);
+    elevated_threshold = elevated > 0.0f ? elevated : 0.0f;
+    critical_threshold = critical > 0.0f ? critical : 0.0f;
+    level_hysteresis = (hysteresis > 0.0f && hysteresis <= 1.0f) ? hysteresis : 1.0f;
+    if (elevated_threshold <= 0.0f) {
+        last_pressure.level = LOAD_LEVEL_NORMAL;
+    }
+    pthread_mutex_unlock(&pressure_mutex);
+}
+
+int pressure_update(SystemPressure *out) {
+    pthread_mutex_lock(&pressure_mutex);
+    int result = refresh_pressure_locked();
+    if (out) {
+        *out = last_pressure;
+    }
+    pthread_mutex_unlock(&pressure_mutex);
+    return result;
+}
+
+LoadLevel pressure_get_level(void) {
+    pthread_mutex_lock(&pressure_mutex);
+    if (elevated_threshold > 0.0f && (!has_reading || elapsed_ms(&last_pressure.taken) >= PSI_REFRESH_MS)) {
+        refresh_pressure_locked();
+    }
+    LoadLevel level = last_pressure.level;
+    pthread_mutex_unlock(&pressure_mutex);
+    return level;
+}
+
+int pressure_interval_factor(LoadLevel level) {
+    switch (level) {
+        case LOAD_LEVEL_CRITICAL:
+            return 4;
+        case LOAD_LEVEL_ELEVATED:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+int pressure_throttle_point(int *budget_ms, volatile int *keep_running) {
+    if ((budget_ms && *budget_ms <= 0) || (keep_running && !*keep_running)) return 0;
+
+    LoadLevel level = pressure_get_level();
+    if (level == LOAD_LEVEL_NORMAL) return 0;
+
+    int limit = level == LOAD_LEVEL_ELEVATED ? PSI_ELEVATED_PAUSE_MS : PSI_CRITICAL_MAX_PAUSE_MS;
+    if (budget_ms && *budget_ms < limit) {
+        limit = *budget_ms;
+    }
+
+    int waited = 0;
+    if (level == LOAD_LEVEL_ELEVATED) {
+        usleep((useconds_t)limit * 1000);
+        waited = limit;
+    } else {
+        // Se revisa la bandera en cada sondeo para que detener el trabajo
+        // no tenga que esperar la pausa completa
+        while (waited < limit && (!keep_running || *keep_running) &&
+               pressure_get_level() == LOAD_LEVEL_CRITICAL) {
+            int step = limit - waited < PSI_CRITICAL_POLL_MS ? limit - waited : PSI_CRITICAL_POLL_MS;
+            usleep((useconds_t)step * 1000);
+            waited += step;
+        }
+    }
+
+    if (budget_ms) {
+        *budget_ms -= waited;
+    }
+    return waited;
+}
+
+const char* pressure_resource_name(PsiResource resource) {
+    switch (resource) {
+        case PSI_CPU:
+            return "CPU";
+        case PSI_MEMORY:
+            return "memoria";
+        case PSI_IO:
+            return "E/S";
+        default:
+            return "desconocido";
+    }
+}
+
+const char* pressure_level_name(LoadLevel level) {
+    switch (level) {
+        case LOAD_LEVEL_CRITICAL:
+            return "crítico";
+        case LOAD_LEVEL_ELEVATED:
+            return "elevado";
+        default:
+            return "normal";
+    }
+}
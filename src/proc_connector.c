@@ -0,0 +1,203 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
+#include "proc_connector.h"
+
+// Tiempo máximo que el hilo espera eventos antes de revisar si debe terminar
+#define PROC_CONN_POLL_TIMEOUT_MS 500
+
+// ============================================================================
+// ESTADO DEL CONECTOR
+// ============================================================================
+
+static int conn_socket = -1;
+static pthread_t conn_thread;
+static volatile int conn_running = 0;
+static ProcConnectorHandler conn_handler = NULL;
+
+// ============================================================================
+// FUNCIONES AUXILIARES DE NETLINK
+// ============================================================================
+
+/**
+ * Envía al kernel la orden de empezar o dejar de enviar eventos de procesos
+ *
+ * @param op: PROC_CN_MCAST_LISTEN o PROC_CN_MCAST_IGNORE
+ * @return int: 0 si es exitoso, -1 si hay error
+ */
+static int send_mcast_op(int sock, enum proc_cn_mcast_op op) {
+    union {
+        struct nlmsghdr hdr;
+        char raw[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))];
+    } msg;
+    memset(&msg, 0, sizeof(msg));
+
+    msg.hdr.nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op));
+    msg.hdr.nlmsg_type = NLMSG_DONE;
+    msg.hdr.nlmsg_pid = 0;
+
+    struct cn_msg *cn = (struct cn_msg *)NLMSG_DATA(&msg.hdr);
+    cn->id.idx = CN_IDX_PROC;
+    cn->id.val = CN_VAL_PROC;
+    cn->len = sizeof(enum proc_cn_mcast_op);
+    memcpy(cn->data, &op, sizeof(op));
+
+    if (send(sock, &msg, msg.hdr.nlmsg_len, 0) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Traduce un evento del kernel y lo despacha al manejador. Los eventos de
+ * hilos (pid != tgid) se descartan: el monitor trabaja a nivel de proceso.
+ */
+static void dispatch_proc_event(const struct proc_event *ev) {
+    switch (ev->what) {
+        case PROC_EVENT_FORK:
+            if (ev->event_data.fork.child_pid == ev->event_data.fork.child_tgid) {
+                conn_handler(PROC_CONN_FORK, ev->event_data.fork.child_tgid);
+            }
+            break;
+        case PROC_EVENT_EXEC:
+            if (ev->event_data.exec.process_pid == ev->event_data.exec.process_tgid) {
+                conn_handler(PROC_CONN_EXEC, ev->event_data.exec.process_tgid);
+            }
+            break;
+        case PROC_EVENT_EXIT:
+            if (ev->event_data.exit.process_pid == ev->event_data.exit.process_tgid) {
+                conn_handler(PROC_CONN_EXIT, ev->event_data.exit.process_tgid);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// ============================================================================
+// HILO RECEPTOR
+// ============================================================================
+
+static void* proc_connector_thread(void *arg) {
+    (void)arg;
+
+    union {
+        struct nlmsghdr hdr;
+        char raw[8192];
+    } buf;
+
+    struct pollfd pfd = { .fd = conn_socket, .events = POLLIN };
+
+    while (conn_running) {
+        int ready = poll(&pfd, 1, PROC_CONN_POLL_TIMEOUT_MS);
+        if (ready <= 0) {
+            continue; // Timeout o EINTR: revisar conn_running
+        }
+
+        ssize_t len = recv(conn_socket, &buf, sizeof(buf), 0);
+        if (len < 0) {
+            if (errno == ENOBUFS) {
+                // El kernel descartó eventos; el recorrido periódico de /proc
+                // reconcilia los procesos perdidos en el siguiente ciclo
+                fprintf(stderr, "[WARNING] Conector de procesos: eventos perdidos (ENOBUFS)\n");
+            }
+            continue;
+        }
+
+        struct nlmsghdr *nlh = &buf.hdr;
+        int remaining = (int)len;
+        for (; NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining)) {
+            if (nlh->nlmsg_type == NLMSG_NOOP || nlh->nlmsg_type == NLMSG_ERROR) {
+                continue;
+            }
+
+            struct cn_msg *cn = (struct cn_msg *)NLMSG_DATA(nlh);
+            if (cn->id.idx != CN_IDX_PROC || cn->id.val != CN_VAL_PROC) {
+                continue;
+            }
+
+            dispatch_proc_event((const struct proc_event *)cn->data);
+        }
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+int proc_connector_start(ProcConnectorHandler handler) {
+    if (!handler) return -1;
+    if (conn_running) return 1;
+
+    int sock = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (sock < 0) {
+        fprintf(stderr, "[WARNING] Conector de procesos no disponible: %s\n", strerror(errno));
+        return -1;
+    }
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = CN_IDX_PROC;
+    addr.nl_pid = 0; // El kernel asigna el identificador
+
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        fprintf(stderr, "[WARNING] No se pudo suscribir al conector de procesos: %s\n",
+                strerror(errno));
+        close(sock);
+        return -1;
+    }
+
+    if (send_mcast_op(sock, PROC_CN_MCAST_LISTEN) != 0) {
+        fprintf(stderr, "[WARNING] El kernel rechazó la suscripción a eventos de procesos: %s\n",
+                strerror(errno));
+        close(sock);
+        return -1;
+    }
+
+    conn_socket = sock;
+    conn_handler = handler;
+    conn_running = 1;
+
+    int result = pthread_create(&conn_thread, NULL, proc_connector_thread, NULL);
+    if (result != 0) {
+        fprintf(stderr, "[ERROR] No se pudo crear el hilo del conector de procesos: %d\n", result);
+        conn_running = 0;
+        send_mcast_op(sock, PROC_CN_MCAST_IGNORE);
+        close(sock);
+        conn_socket = -1;
+        return -1;
+    }
+
+    printf("[INFO] Conector de procesos activo: eventos fork/exec/exit en tiempo real\n");
+    return 0;
+}
+
+void proc_connector_stop(void) {
+    if (!conn_running) return;
+
+    conn_running = 0;
+    pthread_join(conn_thread, NULL);
+
+    send_mcast_op(conn_socket, PROC_CN_MCAST_IGNORE);
+    close(conn_socket);
+    conn_socket = -1;
+    conn_handler = NULL;
+
+    printf("[INFO] Conector de procesos detenido\n");
+}
+
+int proc_connector_is_active(void) {
+    return conn_running;
+}
@@ -0,0 +1,221 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "process_history.h"
+
+// Anillos que se reservan al crear la arena; luego crece al doble hasta el tope
+#define HISTORY_INITIAL_RINGS 256
+// Límite impuesto por los contadores de 16 bits de la cabecera
+#define HISTORY_MAX_LENGTH 65535
+
+// ============================================================================
+// ESTADO DE LA ARENA
+// ============================================================================
+
+// Todas las muestras viven en un único bloque: el anillo i ocupa
+// [i * ring_length, (i + 1) * ring_length)
+static HistorySample *arena = NULL;
+static HistoryRing *rings = NULL;
+static int ring_capacity = 0;       // Anillos reservados en la arena
+static int ring_limit = 0;          // Anillos que caben bajo el tope de memoria
+static int rings_high_water = 0;    // Anillos usados alguna vez
+static int first_free_ring = -1;
+static int ring_length = 0;
+static int cap_warning_shown = 0;
+
+static int has_epoch = 0;
+static struct timespec epoch;
+
+// Protege la arena frente a lecturas desde otros hilos (GUI)
+static pthread_mutex_t history_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// ============================================================================
+// FUNCIONES AUXILIARES
+// ============================================================================
+
+static uint16_t to_fixed16(float value, float scale) {
+    if (value <= 0.0f) return 0;
+    float scaled = value * scale + 0.5f;
+    return scaled >= 65535.0f ? 65535 : (uint16_t)scaled;
+}
+
+static uint32_t to_u32(unsigned long value) {
+    return value > UINT32_MAX ? UINT32_MAX : (uint32_t)value;
+}
+
+/**
+ * Duplica la arena sin superar el tope configurado
+ * @return int: 0 si es exitoso, -1 si no hay espacio
+ */
+static int grow_arena(void) {
+    if (ring_capacity >= ring_limit) return -1;
+
+    int new_capacity = ring_capacity ? ring_capacity * 2 : HISTORY_INITIAL_RINGS;
+    if (new_capacity > ring_limit) new_capacity = ring_limit;
+
+    HistorySample *new_arena = realloc(arena,
+        (size_t)new_capacity * ring_length * sizeof(HistorySample));
+    if (!new_arena) return -1;
+    arena = new_arena;
+
+    HistoryRing *new_rings = realloc(rings, (size_t)new_capacity * sizeof(HistoryRing));
+    if (!new_rings) return -1;
+    rings = new_rings;
+
+    ring_capacity = new_capacity;
+    return 0;
+}
+
+static void reset_arena(void) {
+    free(arena);
+    free(rings);
+    arena = NULL;
+    rings = NULL;
+    ring_capacity = 0;
+    rings_high_water = 0;
+    first_free_ring = -1;
+    cap_warning_shown = 0;
+    has_epoch = 0;
+}
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+void history_configure(int samples_per_process, size_t max_bytes) {
+    pthread_mutex_lock(&history_mutex);
+    reset_arena();
+
+    if (samples_per_process > HISTORY_MAX_LENGTH) samples_per_process = HISTORY_MAX_LENGTH;
+    ring_length = samples_per_process > 0 ? samples_per_process : 0;
+
+    size_t ring_bytes = (size_t)ring_length * sizeof(HistorySample);
+    size_t limit = ring_bytes ? max_bytes / ring_bytes : 0;
+    ring_limit = limit > (size_t)INT32_MAX ? INT32_MAX : (int)limit;
+
+    pthread_mutex_unlock(&history_mutex);
+
+    if (ring_limit > 0) {
+        printf("[INFO] Historial de procesos: %d muestras por proceso, hasta %d procesos (%zu KB)\n",
+               ring_length, ring_limit, max_bytes / 1024);
+    } else {
+        printf("[INFO] Historial de procesos deshabilitado\n");
+    }
+}
+
+int history_alloc(pid_t pid, unsigned long starttime) {
+    pthread_mutex_lock(&history_mutex);
+
+    int ring = -1;
+    if (first_free_ring >= 0) {
+        ring = first_free_ring;
+        first_free_ring = rings[ring].next_free;
+    } else if (rings_high_water < ring_capacity || grow_arena() == 0) {
+        ring = rings_high_water++;
+    } else if (ring_limit > 0 && !cap_warning_shown) {
+        cap_warning_shown = 1;
+        fprintf(stderr, "[WARNING] Tope de memoria del historial alcanzado (%d procesos); "
+                "los procesos nuevos no tendrán historial\n", ring_limit);
+    }
+
+    if (ring >= 0) {
+        rings[ring].pid = pid;
+        rings[ring].starttime = starttime;
+        rings[ring].head = 0;
+        rings[ring].count = 0;
+        rings[ring].next_free = -1;
+    }
+
+    pthread_mutex_unlock(&history_mutex);
+    return ring;
+}
+
+void history_release(int ring) {
+    pthread_mutex_lock(&history_mutex);
+    if (ring >= 0 && ring < rings_high_water && rings[ring].pid != 0) {
+        rings[ring].pid = 0;
+        rings[ring].next_free = first_free_ring;
+        first_free_ring = ring;
+    }
+    pthread_mutex_unlock(&history_mutex);
+}
+
+void history_record(int ring, const struct timespec *now, float cpu_usage, float mem_usage,
+                    unsigned long rss_kb, unsigned long io_kbps) {
+    if (ring < 0) return;
+
+    pthread_mutex_lock(&history_mutex);
+    if (ring >= rings_high_water || rings[ring].pid == 0) {
+        pthread_mutex_unlock(&history_mutex);
+        return;
+    }
+
+    if (!has_epoch) {
+        epoch = *now;
+        has_epoch = 1;
+    }
+    long long elapsed_cs = (long long)(now->tv_sec - epoch.tv_sec) * 100 +
+                           (now->tv_nsec - epoch.tv_nsec) / 10000000;
+
+    HistoryRing *r = &rings[ring];
+    HistorySample *s = &arena[(size_t)ring * ring_length + r->head];
+    s->time_cs = elapsed_cs < 0 ? 0 : (elapsed_cs > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed_cs);
+    s->rss_kb = to_u32(rss_kb);
+    s->io_kbps = to_u32(io_kbps);
+    s->cpu_x10 = to_fixed16(cpu_usage, 10.0f);
+    s->mem_x100 = to_fixed16(mem_usage, 100.0f);
+
+    r->head = (uint16_t)((r->head + 1) % ring_length);
+    if (r->count < ring_length) r->count++;
+
+    pthread_mutex_unlock(&history_mutex);
+}
+
+int history_get_series(pid_t pid, ProcessHistoryPoint *out, int max_points) {
+    if (pid <= 0 || !out || max_points <= 0) return -1;
+
+    pthread_mutex_lock(&history_mutex);
+
+    int ring = -1;
+    for (int i = 0; i < rings_high_water; i++) {
+        if (rings[i].pid == pid) {
+            ring = i;
+            break;
+        }
+    }
+    if (ring < 0) {
+        pthread_mutex_unlock(&history_mutex);
+        return -1;
+    }
+
+    const HistoryRing *r = &rings[ring];
+    const HistorySample *base = &arena[(size_t)ring * ring_length];
+
+    // Si el buffer es menor que la serie se devuelven las muestras más recientes
+    int n = r->count < max_points ? r->count : max_points;
+    int start = (r->head - n + ring_length) % ring_length;
+
+    for (int i = 0; i < n; i++) {
+        const HistorySample *s = &base[(start + i) % ring_length];
+        out[i].elapsed_seconds = s->time_cs / 100.0;
+        out[i].cpu_usage = s->cpu_x10 / 10.0f;
+        out[i].mem_usage = s->mem_x100 / 100.0f;
+        out[i].rss_kb = s->rss_kb;
+        out[i].io_kbps = s->io_kbps;
+    }
+
+    pthread_mutex_unlock(&history_mutex);
+    return n;
+}
+
+int history_length(void) {
+    return ring_length;
+}
+
+void history_cleanup(void) {
+    pthread_mutex_lock(&history_mutex);
+    reset_arena();
+    pthread_mutex_unlock(&history_mutex);
+}
@@ -2,13 +2,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <dirent.h>
+#include <stdint.h>
 #include <unistd.h>
 #include <signal.h>
 #include <time.h>
+#include <stdarg.h>
+#include <errno.h>
 #include <pthread.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
 #include <sys/sysinfo.h>
 #include "process_monitor.h"
+#include "proc_connector.h"
+#include "cgroup_monitor.h"
+#include "process_whitelist.h"
+#include "string_pool.h"
 
 // ===== VARIABLES GLOBALES =====
 
@@ -19,58 +27,287 @@ pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
 FILE *log_file = NULL;
 
 // Variables globales para procesos activos
+// procesos_activos es un slab de ranuras que crece geométricamente y nunca se
+// encoge; las ranuras liberadas se encadenan en una lista libre para reutilizarse
+#define PROCESS_SLAB_INITIAL_CAPACITY 256
 ActiveProcess *procesos_activos = NULL;
-int num_procesos_activos = 0;
+int num_procesos_activos = 0;           // Procesos vivos
+static int procesos_capacidad = 0;      // Ranuras reservadas
+static int procesos_high_water = 0;     // Ranuras usadas alguna vez (límite de recorrido)
+static int primera_ranura_libre = -1;   // Cabeza de la lista libre
+
+// Columnas calientes del slab, con la misma capacidad: los recorridos por
+// estado o por umbral no tocan las ranuras completas
+static ProcessColumns proc_columns = {0};
+
+// Orden en anchura del árbol de procesos, reutilizado en cada ciclo
+static int *tree_order = NULL;
+static int tree_order_capacity = 0;
+
+// Índice hash PID -> ranura para búsquedas O(1) sobre procesos_activos
+static PidIndexEntry *pid_index = NULL;
+static size_t pid_index_capacity = 0;   // Siempre potencia de 2
+static size_t pid_index_count = 0;
+
+// El historial se dimensiona con la configuración al registrar el primer proceso
+static int history_configured = 0;
 
 // Variables para control de hilos de monitoreo
 static pthread_t monitoring_thread;
 static volatile int monitoring_active = 0;
 static volatile int should_stop = 0;
 
+// El hilo de monitoreo espera sobre esta condición (reloj CLOCK_MONOTONIC) para
+// poder despertarse de inmediato al detenerse o al cambiar el intervalo
+static pthread_cond_t monitor_wakeup;
+static int monitor_wakeup_ready = 0;
+
+// Procesos en el nivel rápido: se vuelven a leer entre ciclos completos
+#define FAST_INTERVAL_MIN_MS 50
+static int num_fast_processes = 0;
+
+// Por debajo de este porcentaje de CPU un proceso se considera inactivo
+#define IDLE_CPU_THRESHOLD 0.5f
+
 // Callbacks opcionales para eventos
 static ProcessCallbacks *event_callbacks = NULL;
 
+// Diff pendiente de entregar con on_cycle_delta, una lista por tipo de cambio
+#define DELTA_INITIAL_CAPACITY 64
+#define DELTA_COALESCE_WINDOW 16          // Entradas recientes revisadas para fusionar un mismo PID
+#define DELTA_FLUSH_MAX_ENTRIES 256       // Entradas que fuerzan la entrega sin esperar el plazo rápido
+static DeltaList delta_lists[DELTA_LIST_COUNT];
+static unsigned long delta_cycle = 0;
+
+// Mensajes del ciclo: se acumulan bajo el mutex y se escriben con el diff
+#define LOG_BUFFER_INITIAL_CAPACITY 4096
+static LogBuffer pending_log;
+
+// Límite global de notificaciones y resumen de las retenidas
+#define ALERT_SUMMARY_INTERVAL 10
+#define ALERT_THRESHOLD_KINDS (ALERT_KIND_CPU | ALERT_KIND_MEMORY | ALERT_KIND_IO)
+static AlertRateLimiter alert_limiter;
+
+// Lectura de PSI y alertas de presión del sistema
+static PressureAlertState pressure_state = { .available = -1 };
+
+// Variación mínima para que un proceso aparezca en la lista de cambios
+#define DELTA_CPU_MIN_CHANGE 1.0f
+#define DELTA_MEM_MIN_CHANGE 0.1f
+
+// Tabla hash en memoria con la muestra previa de CPU de cada proceso
+#define CPU_SAMPLE_INITIAL_CAPACITY 1024
+static CpuSample *cpu_samples = NULL;
+static size_t cpu_samples_capacity = 0;   // Siempre potencia de 2
+static size_t cpu_samples_count = 0;
+static unsigned int cpu_sample_generation = 0;
+
+// Intervalo mínimo entre dos muestras para que el delta de ticks sea significativo
+#define CPU_SAMPLE_MIN_ELAPSED 0.01
+
+// Tamaño del buffer de trabajo para leer /proc/[pid]/stat
+#define STAT_BUFFER_SIZE 1024
+// smaps_rollup ocupa ~700 bytes en kernels recientes; se deja margen
+#define SMAPS_BUFFER_SIZE 2048
+
+// Enumeración de /proc con getdents64: descriptor y buffer reutilizados entre ciclos
+#define DENTS_BUFFER_SIZE (64 * 1024)
+static int proc_dir_fd = -1;
+static uint64_t dents_buffer[DENTS_BUFFER_SIZE / sizeof(uint64_t)];  // Alineado para linux_dirent64
+static pid_t *cycle_pids = NULL;        // PIDs a leer en el ciclo actual
+static int cycle_pids_count = 0;
+static int cycle_pids_capacity = 0;
+
+// Muestras del ciclo, en el mismo orden que cycle_pids (pid == 0 si falló la lectura)
+static ProcSample *cycle_samples = NULL;
+static int cycle_samples_capacity = 0;
+
+// Pool de hilos que reparte la lectura de /proc en fragmentos de PIDs.
+// Los hilos solo leen y parsean; la fusión, las alertas y los callbacks se
+// hacen después en el hilo de monitoreo, en el orden de cycle_pids.
+#define SAMPLER_SHARD_SIZE 128
+#define SAMPLER_MAX_THREADS 64
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    pthread_t threads[SAMPLER_MAX_THREADS];
+    int num_threads;          // Hilos auxiliares (el hilo de monitoreo también muestrea)
+    int target_threads;       // Auxiliares pedidos en la última creación, aunque fallara alguno
+    unsigned int job_id;      // Se incrementa con cada ciclo publicado
+    int next_shard;
+    int num_shards;
+    int busy_workers;         // Auxiliares que aún no terminaron el ciclo publicado
+    int shutdown;
+} SamplerPool;
+
+static SamplerPool sampler_pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_ready = PTHREAD_COND_INITIALIZER,
+    .work_done = PTHREAD_COND_INITIALIZER
+};
+
+// Snapshots publicados para lectores (GUI, coordinador) sin tomar el mutex de muestreo.
+// snapshot_lock solo protege el intercambio del puntero y el incremento de referencias.
+static pthread_mutex_t snapshot_lock = PTHREAD_MUTEX_INITIALIZER;
+static ProcessSnapshot *published_snapshot = NULL;
+static ProcessSnapshot *retired_snapshot = NULL;   // Anterior; se reutiliza si nadie lo retiene
+static unsigned long snapshot_cycle = 0;
+
+// Cgroups vigilados: su ProcessInfo usa el pid sintético -(i + 1) y conserva
+// el estado de alerta entre ciclos igual que un proceso
+static ProcessInfo *cgroup_infos = NULL;
+static CgroupSample *cgroup_samples = NULL;
+static int num_cgroup_infos = 0;
+static int cgroups_configured = 0;
+
+// Contexto del último ciclo, reutilizado por los eventos del conector de procesos
+static CycleContext last_cycle_ctx;
+static int last_cycle_ctx_valid = 0;
+
 // ===== DECLARACIONES DE FUNCIONES PRIVADAS =====
 
 // Funciones de acceso a /proc
-static int read_proc_stat(pid_t pid, ProcStat *stat);
+static int enumerate_pids(void);
+static int open_pid_dir(pid_t pid);
+static ssize_t read_file_at(int dir_fd, const char *name, char *buf, size_t buf_size);
+static int read_proc_sample(pid_t pid, ProcSample *sample, char *buf, size_t buf_size);
+static int read_proc_sample_at(int pid_fd, pid_t pid, ProcSample *sample, char *buf, size_t buf_size);
+static void read_proc_io_at(int pid_fd, ProcSample *sample, char *buf, size_t buf_size);
+static void classify_sample_at(int pid_fd, ProcSample *sample);
+static void read_proc_pss_at(int pid_fd, ProcSample *sample, const CycleContext *ctx);
+
+// Funciones del muestreo paralelo
+static int sample_cycle_pids(void);
+static int select_due_pids(const CycleContext *ctx);
+static void sampler_pool_stop(void);
 static unsigned long get_total_system_memory(void);
+static void capture_cycle_context(CycleContext *ctx);
+
+// Funciones de cálculo a partir de una muestra ya leída
+static int fill_process_info(const CycleContext *ctx, const ProcSample *sample, ProcessInfo *info);
+static float lifetime_cpu_usage(const CycleContext *ctx, const ProcSample *sample);
+static float sample_cpu_usage(const CycleContext *ctx, const ProcSample *sample, pid_t owner);
+static int sample_process_tasks(const CycleContext *ctx, ProcessInfo *info);
+static int should_sample_tasks(const ProcessInfo *info, int idx);
+static float sample_memory_usage(const CycleContext *ctx, const ProcSample *sample);
+static void sample_io_rates(const ProcSample *sample, ProcessInfo *info);
 
-// Funciones de persistencia
-static void get_stat_file_path(pid_t pid, char *path, size_t size);
-static void read_prev_times(pid_t pid, unsigned long *prev_user_time, unsigned long *prev_sys_time);
-static void write_prev_times(pid_t pid, unsigned long prev_user_time, unsigned long prev_sys_time);
+// Funciones de la tabla de muestras de CPU
+static CpuSample* cpu_sample_lookup(pid_t pid, unsigned long starttime, int is_task, int *is_new);
+static void cpu_sample_touch(pid_t pid, unsigned long starttime);
+static void cpu_sample_sweep(void);
+static void cpu_sample_table_clear(void);
 
 // Funciones de gestión de procesos internos
 static int find_process(pid_t pid);
-static void add_process(ProcessInfo info);
-static void remove_process(pid_t pid);
-static void update_process(ProcessInfo info, int idx);
+static int pid_index_insert(pid_t pid, int slot);
+static void pid_index_remove(pid_t pid);
+static int add_process(const ProcessInfo *info, unsigned long starttime);
+static void remove_process(int idx);
+static void record_process_history(const ProcessInfo *info, const struct timespec *taken, int idx);
+static void update_process(const ProcessInfo *info, int idx);
+static void refresh_process(ProcessInfo *info, int idx);
+static void slot_to_info(int idx, ProcessInfo *info);
+
+// Árbol de procesos
+static void tree_update_parent(int idx);
+static void tree_remove(int idx);
+static void aggregate_process_tree(void);
+static void monitor_cycle(void);
+static void sample_fast_processes(void);
+static void schedule_next_sample(int idx, const struct timespec *taken, int first_sample);
+static void set_sampling_tier(int idx, SamplingTier tier);
+static void timespec_add_ms(struct timespec *ts, long ms);
+static int timespec_before(const struct timespec *a, const struct timespec *b);
 static void clear_process_list(void);
-static void show_process_stats(void);
+static void show_process_stats(const ProcessSnapshot *snapshot);
+static void count_threshold_columns(ProcessSnapshot *snapshot);
+
+// Funciones de publicación de snapshots
+static ProcessSnapshot* build_process_snapshot(void);
+static void top_heap_offer(TopHeapEntry *heap, int *size, float key, int index);
+static int top_heap_drain(TopHeapEntry *heap, int size, int *out);
+static void publish_process_snapshot(ProcessSnapshot *snapshot);
+static void clear_process_snapshots(void);
+
+// Diff por ciclo
+static void delta_record(DeltaListKind kind, const ProcessInfo *info, unsigned int alert_kinds);
+static void delta_record_slot(DeltaListKind kind, int idx, unsigned int alert_kinds);
+static int delta_pending(void);
+static int delta_entry_count(void);
+static int take_process_delta(DeltaBatch *batch);
+static void deliver_process_delta(DeltaBatch *batch);
+static void hand_off_process_delta(DeltaBatch *batch);
+static void free_delta_batch(DeltaBatch *batch);
+static void clear_process_delta(void);
+static void monitor_log(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
 
 // Funciones de alertas
 static void check_and_update_alert_status(ProcessInfo *info);
 static void clear_alert_if_needed(ProcessInfo *info);
+static void update_memory_trend(int idx, const struct timespec *taken, const CycleContext *ctx);
+static void check_process_executable(int idx);
+static int alert_may_notify(ProcessState *state, unsigned int kinds, time_t now);
+static int alert_forget_notification(ProcessState *state, unsigned int kinds);
+static int alert_take_suppressed_summary(void);
 
 // Función del hilo de monitoreo
 static void* monitoring_thread_function(void* arg);
 
+// Eventos en tiempo real del conector de procesos
+static void on_proc_connector_event(ProcConnectorEvent event, pid_t pid);
+
+// Monitoreo agregado de cgroups v2
+static void monitor_cgroups(const CycleContext *ctx);
+static void clear_cgroup_state(void);
+
+// Presión del sistema
+static void update_system_pressure(void);
+
 // ===== FUNCIONES DE CONFIGURACIÓN =====
 
 void load_config(void) {
     // Valores predeterminados
     config.max_cpu_usage = 90.0;
     config.max_ram_usage = 80.0;
+    config.max_io_kbps = 0.0;
+    config.subtree_max_cpu = 0.0;
+    config.subtree_max_ram = 0.0;
     config.check_interval = 30;
     config.alert_duration = 10;
     config.num_white_processes = 0;
     config.white_list = NULL;
+    config.use_proc_connector = 0;
+    config.sampler_threads = 1;
+    config.history_length = 60;
+    config.history_max_kb = 4096;
+    config.fast_interval_ms = 250;
+    config.fast_sampling_fraction = 0.8f;
+    config.pss_fraction = 0.5f;
+    config.slow_interval = 60;
+    config.task_monitoring = 0;
+    config.task_cpu_floor = 25.0f;
+    config.cgroup_paths = NULL;
+    config.num_cgroups = 0;
+    config.growth_window = 120;
+    config.growth_min_kbps = 64.0f;
+    config.growth_min_r2 = 0.9f;
+    config.alert_hysteresis = 0.9f;
+    config.alert_cooldown = 60;
+    config.alerts_per_minute = 30;
+    config.alert_burst = 10;
+    config.exe_integrity = 0;
+    config.exe_hash_max_kb = 65536;
+    config.pressure_threshold = 25.0f;
+    config.pressure_critical = 60.0f;
 
     // Cargar desde archivo
     FILE *conf = fopen(CONFIG_PATH, "r");
     if (!conf) {
         printf("[INFO] No se encontró archivo de configuración, usando valores predeterminados\n");
+        whitelist_compile(NULL, 0);
+        pressure_configure(config.pressure_threshold, config.pressure_critical, config.alert_hysteresis);
         return;
     }
 
@@ -84,14 +321,150 @@ void load_config(void) {
         else if (strstr(line, "UMBRAL_RAM=")) {
             sscanf(line, "UMBRAL_RAM=%f", &config.max_ram_usage);
         } 
+        // Actualiza el umbral para alertas de E/S (kB/s)
+        else if (strstr(line, "UMBRAL_IO=")) {
+            sscanf(line, "UMBRAL_IO=%f", &config.max_io_kbps);
+            if (config.max_io_kbps < 0.0f) config.max_io_kbps = 0.0f;
+        } 
+        // Umbrales sobre la suma de un proceso y todos sus descendientes
+        else if (strstr(line, "UMBRAL_SUBARBOL_CPU=")) {
+            sscanf(line, "UMBRAL_SUBARBOL_CPU=%f", &config.subtree_max_cpu);
+            if (config.subtree_max_cpu < 0.0f) config.subtree_max_cpu = 0.0f;
+        } 
+        else if (strstr(line, "UMBRAL_SUBARBOL_RAM=")) {
+            sscanf(line, "UMBRAL_SUBARBOL_RAM=%f", &config.subtree_max_ram);
+            if (config.subtree_max_ram < 0.0f) config.subtree_max_ram = 0.0f;
+        } 
         // Actualiza el intervalo de realización de chequeos
         else if (strstr(line, "INTERVALO=")) {
             sscanf(line, "INTERVALO=%d", &config.check_interval);
         } 
+        // Periodo del muestreo de alta frecuencia
+        else if (strstr(line, "INTERVALO_RAPIDO_MS=")) {
+            sscanf(line, "INTERVALO_RAPIDO_MS=%d", &config.fast_interval_ms);
+            if (config.fast_interval_ms < FAST_INTERVAL_MIN_MS) config.fast_interval_ms = FAST_INTERVAL_MIN_MS;
+        } 
+        // Periodo para procesos inactivos o en whitelist
+        else if (strstr(line, "INTERVALO_LENTO=")) {
+            sscanf(line, "INTERVALO_LENTO=%d", &config.slow_interval);
+            if (config.slow_interval < 1) config.slow_interval = 1;
+        } 
+        // Fracción de los umbrales que activa el muestreo rápido
+        else if (strstr(line, "FRACCION_RAPIDA=")) {
+            sscanf(line, "FRACCION_RAPIDA=%f", &config.fast_sampling_fraction);
+            if (config.fast_sampling_fraction < 0.0f) config.fast_sampling_fraction = 0.0f;
+        } 
+        // Fracción del umbral de RAM que activa la medición con PSS
+        else if (strstr(line, "FRACCION_PSS=")) {
+            sscanf(line, "FRACCION_PSS=%f", &config.pss_fraction);
+            if (config.pss_fraction < 0.0f) config.pss_fraction = 0.0f;
+        } 
+        // Activa el descenso a los hilos de los procesos calientes
+        else if (strstr(line, "MONITOREO_TAREAS=")) {
+            sscanf(line, "MONITOREO_TAREAS=%d", &config.task_monitoring);
+        } 
+        // CPU% mínimo para leer los hilos de un proceso
+        else if (strstr(line, "TAREAS_CPU_MIN=")) {
+            sscanf(line, "TAREAS_CPU_MIN=%f", &config.task_cpu_floor);
+            if (config.task_cpu_floor < 0.0f) config.task_cpu_floor = 0.0f;
+        } 
         // Actualiza la duración del estado de alerta
         else if (strstr(line, "DURACION_ALERTA=")) {
             sscanf(line, "DURACION_ALERTA=%d", &config.alert_duration);
         } 
+        // Activa el seguimiento de procesos por eventos del kernel
+        else if (strstr(line, "EVENTOS_PROCESOS=")) {
+            sscanf(line, "EVENTOS_PROCESOS=%d", &config.use_proc_connector);
+        } 
+        // Número de hilos que leen /proc en paralelo
+        else if (strstr(line, "HILOS_MUESTREO=")) {
+            sscanf(line, "HILOS_MUESTREO=%d", &config.sampler_threads);
+            if (config.sampler_threads < 1) config.sampler_threads = 1;
+            if (config.sampler_threads > SAMPLER_MAX_THREADS) config.sampler_threads = SAMPLER_MAX_THREADS;
+        } 
+        // Muestras de historial que se conservan por proceso
+        else if (strstr(line, "HISTORIAL_MUESTRAS=")) {
+            sscanf(line, "HISTORIAL_MUESTRAS=%d", &config.history_length);
+            if (config.history_length < 0) config.history_length = 0;
+        } 
+        // Tope de memoria para el historial de todos los procesos
+        else if (strstr(line, "HISTORIAL_MAX_KB=")) {
+            sscanf(line, "HISTORIAL_MAX_KB=%d", &config.history_max_kb);
+            if (config.history_max_kb < 0) config.history_max_kb = 0;
+        } 
+        // Ventana de la regresión del RSS que detecta fugas de memoria
+        else if (strstr(line, "TENDENCIA_VENTANA=")) {
+            sscanf(line, "TENDENCIA_VENTANA=%d", &config.growth_window);
+            if (config.growth_window < 0) config.growth_window = 0;
+        } 
+        // Pendiente (kB/s) y R² mínimos de un crecimiento sostenido
+        else if (strstr(line, "TENDENCIA_KBPS=")) {
+            sscanf(line, "TENDENCIA_KBPS=%f", &config.growth_min_kbps);
+            if (config.growth_min_kbps < 0.0f) config.growth_min_kbps = 0.0f;
+        } 
+        else if (strstr(line, "TENDENCIA_R2=")) {
+            sscanf(line, "TENDENCIA_R2=%f", &config.growth_min_r2);
+            if (config.growth_min_r2 < 0.0f) config.growth_min_r2 = 0.0f;
+            if (config.growth_min_r2 > 1.0f) config.growth_min_r2 = 1.0f;
+        } 
+        // Fracción de cada umbral por debajo de la cual se despeja una alerta
+        else if (strstr(line, "HISTERESIS=")) {
+            sscanf(line, "HISTERESIS=%f", &config.alert_hysteresis);
+            if (config.alert_hysteresis < 0.0f) config.alert_hysteresis = 0.0f;
+            if (config.alert_hysteresis > 1.0f) config.alert_hysteresis = 1.0f;
+        } 
+        // Segundos sin volver a notificar a un mismo proceso
+        else if (strstr(line, "ALERTA_ENFRIAMIENTO=")) {
+            sscanf(line, "ALERTA_ENFRIAMIENTO=%d", &config.alert_cooldown);
+            if (config.alert_cooldown < 0) config.alert_cooldown = 0;
+        } 
+        // Límite global de notificaciones: ritmo sostenido y ráfaga
+        else if (strstr(line, "ALERTAS_POR_MINUTO=")) {
+            sscanf(line, "ALERTAS_POR_MINUTO=%d", &config.alerts_per_minute);
+            if (config.alerts_per_minute < 0) config.alerts_per_minute = 0;
+        } 
+        else if (strstr(line, "ALERTAS_RAFAGA=")) {
+            sscanf(line, "ALERTAS_RAFAGA=%d", &config.alert_burst);
+            if (config.alert_burst < 1) config.alert_burst = 1;
+        } 
+        // Hash de los ejecutables en ejecución y detección de binarios borrados o memfd
+        else if (strstr(line, "INTEGRIDAD_EJECUTABLES=")) {
+            sscanf(line, "INTEGRIDAD_EJECUTABLES=%d", &config.exe_integrity);
+        } 
+        else if (strstr(line, "INTEGRIDAD_MAX_KB=")) {
+            sscanf(line, "INTEGRIDAD_MAX_KB=%d", &config.exe_hash_max_kb);
+            if (config.exe_hash_max_kb < 0) config.exe_hash_max_kb = 0;
+        } 
+        // Presión del sistema (PSI) que frena el monitor y alerta
+        else if (strstr(line, "PRESION_UMBRAL=")) {
+            sscanf(line, "PRESION_UMBRAL=%f", &config.pressure_threshold);
+            if (config.pressure_threshold < 0.0f) config.pressure_threshold = 0.0f;
+        } 
+        else if (strstr(line, "PRESION_CRITICA=")) {
+            sscanf(line, "PRESION_CRITICA=%f", &config.pressure_critical);
+            if (config.pressure_critical < 0.0f) config.pressure_critical = 0.0f;
+        } 
+        // Cgroups v2 a vigilar como una unidad
+        else if (strstr(line, "CGROUPS=")) {
+            char *list = strchr(line, '=') + 1;
+            list[strcspn(list, "\n")] = 0;
+            
+            char *token = strtok(list, ",");
+            while (token) {
+                char **temp_list = realloc(config.cgroup_paths,
+                                           (config.num_cgroups + 1) * sizeof(char*));
+                if (!temp_list) {
+                    fprintf(stderr, "[ERROR] No se pudo expandir la lista de cgroups\n");
+                    break;
+                }
+                config.cgroup_paths = temp_list;
+                config.cgroup_paths[config.num_cgroups] = strdup(token);
+                if (config.cgroup_paths[config.num_cgroups]) {
+                    config.num_cgroups++;
+                }
+                token = strtok(NULL, ",");
+            }
+        }
         // Actualiza los procesos a tener en cuenta en la lista blanca
         else if (strstr(line, "WHITELIST=")) {
             char *list = strchr(line, '=') + 1;
@@ -122,6 +495,13 @@ void load_config(void) {
     }
 
     fclose(conf);
+    
+    // Nombres exactos a un conjunto hash, patrones precompilados
+    whitelist_compile(config.white_list, config.num_white_processes);
+    
+    // El regulador de carga también lo consultan los escaneos de dispositivos
+    pressure_configure(config.pressure_threshold, config.pressure_critical, config.alert_hysteresis);
+    
     printf("[INFO] Configuración cargada: CPU=%.1f%%, RAM=%.1f%%, Intervalo=%ds, Duración alerta=%ds\n",
            config.max_cpu_usage, config.max_ram_usage, config.check_interval, config.alert_duration);
 }
@@ -181,8 +561,39 @@ void save_config(void) {
     // Escribir la configuración actual
     fprintf(conf, "UMBRAL_CPU=%.1f\n", config.max_cpu_usage);
     fprintf(conf, "UMBRAL_RAM=%.1f\n", config.max_ram_usage);
+    fprintf(conf, "UMBRAL_IO=%.1f\n", config.max_io_kbps);
+    fprintf(conf, "UMBRAL_SUBARBOL_CPU=%.1f\n", config.subtree_max_cpu);
+    fprintf(conf, "UMBRAL_SUBARBOL_RAM=%.1f\n", config.subtree_max_ram);
     fprintf(conf, "INTERVALO=%d\n", config.check_interval);
+    fprintf(conf, "INTERVALO_RAPIDO_MS=%d\n", config.fast_interval_ms);
+    fprintf(conf, "INTERVALO_LENTO=%d\n", config.slow_interval);
+    fprintf(conf, "FRACCION_RAPIDA=%.2f\n", config.fast_sampling_fraction);
+    fprintf(conf, "FRACCION_PSS=%.2f\n", config.pss_fraction);
+    fprintf(conf, "MONITOREO_TAREAS=%d\n", config.task_monitoring);
+    fprintf(conf, "TAREAS_CPU_MIN=%.1f\n", config.task_cpu_floor);
     fprintf(conf, "DURACION_ALERTA=%d\n", config.alert_duration);
+    fprintf(conf, "EVENTOS_PROCESOS=%d\n", config.use_proc_connector);
+    fprintf(conf, "HILOS_MUESTREO=%d\n", config.sampler_threads);
+    fprintf(conf, "HISTORIAL_MUESTRAS=%d\n", config.history_length);
+    fprintf(conf, "HISTORIAL_MAX_KB=%d\n", config.history_max_kb);
+    fprintf(conf, "TENDENCIA_VENTANA=%d\n", config.growth_window);
+    fprintf(conf, "TENDENCIA_KBPS=%.1f\n", config.growth_min_kbps);
+    fprintf(conf, "TENDENCIA_R2=%.2f\n", config.growth_min_r2);
+    fprintf(conf, "HISTERESIS=%.2f\n", config.alert_hysteresis);
+    fprintf(conf, "ALERTA_ENFRIAMIENTO=%d\n", config.alert_cooldown);
+    fprintf(conf, "ALERTAS_POR_MINUTO=%d\n", config.alerts_per_minute);
+    fprintf(conf, "ALERTAS_RAFAGA=%d\n", config.alert_burst);
+    fprintf(conf, "INTEGRIDAD_EJECUTABLES=%d\n", config.exe_integrity);
+    fprintf(conf, "INTEGRIDAD_MAX_KB=%d\n", config.exe_hash_max_kb);
+    fprintf(conf, "PRESION_UMBRAL=%.1f\n", config.pressure_threshold);
+    fprintf(conf, "PRESION_CRITICA=%.1f\n", config.pressure_critical);
+    
+    // Escribir los cgroups vigilados
+    fprintf(conf, "CGROUPS=");
+    for (int i = 0; i < config.num_cgroups; i++) {
+        fprintf(conf, "%s%s", config.cgroup_paths[i], i < config.num_cgroups - 1 ? "," : "");
+    }
+    fprintf(conf, "\n");
     
     // Escribir la whitelist
     fprintf(conf, "WHITELIST=");
@@ -201,8 +612,10 @@ void save_config(void) {
 // ===== FUNCIONES DE INFORMACIÓN DE PROCESOS =====
 
 ProcessInfo* get_process_info(pid_t pid) {
-    // Verificar que el proceso existe
-    if (!process_exists(pid)) {
+    // Una sola lectura de /proc/[pid]/stat; si falla, el proceso no existe
+    char buf[STAT_BUFFER_SIZE];
+    ProcSample sample;
+    if (read_proc_sample(pid, &sample, buf, sizeof(buf)) != 0) {
         return NULL;
     }
     
@@ -212,36 +625,48 @@ ProcessInfo* get_process_info(pid_t pid) {
         return NULL;
     }
     
-    // Inicializar estructura
-    memset(info, 0, sizeof(ProcessInfo));
-    info->pid = pid;
-    
-    // Obtener nombre del proceso
-    get_process_name(pid, info->name, sizeof(info->name));
-    
-    // Si no se pudo obtener el nombre, el proceso probablemente terminó
-    if (strlen(info->name) == 0 || strstr(info->name, "unknown_")) {
+    CycleContext ctx;
+    capture_cycle_context(&ctx);
+    if (fill_process_info(&ctx, &sample, info) != 0) {
         free(info);
         return NULL;
     }
     
-    // Verificar si está en whitelist
-    info->is_whitelisted = is_process_whitelisted(info->name);
+    return info;
+}
+
+/**
+ * Construye un ProcessInfo a partir de una muestra de /proc/[pid]/stat,
+ * sin volver a leer procfs salvo la muestra previa de CPU en memoria.
+ * 
+ * @return 0 si es exitoso, -1 si la muestra no tiene nombre válido
+ */
+static int fill_process_info(const CycleContext *ctx, const ProcSample *sample, ProcessInfo *info) {
+    // Inicializar estructura (campos de alerta a cero)
+    memset(info, 0, sizeof(ProcessInfo));
+    info->pid = sample->pid;
+    info->ppid = sample->ppid;
     
-    // Obtener uso de CPU
-    info->cpu_usage = interval_cpu_usage(pid);
+    if (sample->name[0] == '\0') {
+        return -1;
+    }
+    strncpy(info->name, sample->name, sizeof(info->name) - 1);
     
-    // Obtener uso de memoria
-    info->mem_usage = get_process_memory_usage(pid);
+    // Veredicto de whitelist calculado al leer la muestra
+    info->is_whitelisted = sample->whitelisted;
     
-    // Inicializar campos de alerta
-    info->alerta_activa = 0;
-    info->inicio_alerta = 0;
-    info->exceeds_thresholds = 0;
-    info->first_threshold_exceed = 0;
-    info->cpu_time = 0.0;
+    // Obtener uso de CPU y memoria desde la misma muestra
+    info->cpu_usage = sample_cpu_usage(ctx, sample, 0);
+    info->mem_usage = sample_memory_usage(ctx, sample);
+    info->rss_kb = sample->rss > 0 ? (unsigned long)sample->rss * (unsigned long)ctx->page_size_kb : 0;
+    if (sample->has_pss) {
+        info->pss_kb = sample->pss_kb;
+        info->swap_kb = sample->swap_kb;
+        info->mem_precise = 1;
+    }
+    sample_io_rates(sample, info);
     
-    return info;
+    return 0;
 }
 
 int process_exists(pid_t pid) {
@@ -256,42 +681,13 @@ int process_exists(pid_t pid) {
 }
 
 void get_process_name(pid_t pid, char *name, size_t size) {
-    // Intentar primero /proc/[pid]/comm (más confiable)
-    char comm_path[256];
-    sprintf(comm_path, "/proc/%d/comm", pid);
-    FILE *fp = fopen(comm_path, "r");
-    
-    if (fp) {
-        if (fgets(name, size, fp)) {
-            // Remover \n al final
-            name[strcspn(name, "\n")] = '\0';
-            fclose(fp);
-            return;
-        }
-        fclose(fp);
-    }
-    
-    // Si comm falla, intentar desde /proc/[pid]/stat
-    char stat_path[256];
-    sprintf(stat_path, "/proc/%d/stat", pid);
-    fp = fopen(stat_path, "r");
+    char buf[STAT_BUFFER_SIZE];
+    ProcSample sample;
     
-    if (fp) {
-        char comm_field[256];
-        if (fscanf(fp, "%*d %255s", comm_field) == 1) {
-            // Remover paréntesis del nombre
-            if (comm_field[0] == '(' && comm_field[strlen(comm_field)-1] == ')') {
-                comm_field[strlen(comm_field)-1] = '\0';
-                strncpy(name, comm_field + 1, size - 1);
-                name[size - 1] = '\0';
-            } else {
-                strncpy(name, comm_field, size - 1);
-                name[size - 1] = '\0';
-            }
-            fclose(fp);
-            return;
-        }
-        fclose(fp);
+    if (read_proc_sample(pid, &sample, buf, sizeof(buf)) == 0 && sample.name[0] != '\0') {
+        strncpy(name, sample.name, size - 1);
+        name[size - 1] = '\0';
+        return;
     }
     
     // Si todo falla, nombre por defecto
@@ -299,215 +695,874 @@ void get_process_name(pid_t pid, char *name, size_t size) {
 }
 
 int is_process_whitelisted(const char *process_name) {
-    if (!process_name || !config.white_list) return 0;
-    
-    for (int i = 0; i < config.num_white_processes; i++) {
-        if (config.white_list[i] && strcmp(process_name, config.white_list[i]) == 0) {
-            return 1;
-        }
-    }
-    return 0;
+    // Solo el nombre: los patrones exe: y cmdline: necesitan el proceso
+    return whitelist_match_name(process_name);
 }
 
 // ===== FUNCIONES DE MONITOREO PRINCIPAL =====
 
 void monitor_processes(void) {
-    DIR *dir = opendir("/proc");
-    if (!dir) {
-        perror("Error al abrir /proc");
-        return;
+    DeltaBatch batch;
+    memset(&batch, 0, sizeof(DeltaBatch));
+    
+    monitor_cycle();
+    if (take_process_delta(&batch)) {
+        deliver_process_delta(&batch);
+    }
+    free_delta_batch(&batch);
+}
+
+/**
+ * Ciclo completo de muestreo. No entrega nada: el diff y los mensajes quedan
+ * pendientes para que el llamador los extraiga con take_process_delta() y
+ * los entregue tras soltar el mutex global.
+ */
+static void monitor_cycle(void) {
+    // La presión del sistema decide cuánto trabajo hace este ciclo
+    update_system_pressure();
+    
+    // Capturar una sola vez las constantes del sistema para todo el ciclo
+    CycleContext ctx;
+    capture_cycle_context(&ctx);
+    last_cycle_ctx = ctx;
+    last_cycle_ctx_valid = 1;
+
+    // Los hashes de ejecutables se calculan fuera del ciclo, en su propio hilo
+    if (config.exe_integrity) {
+        exe_integrity_start((unsigned long)config.exe_hash_max_kb);
     }
 
     // 1. Marcar todos los procesos actuales como "no encontrados"
-    for (int i = 0; i < num_procesos_activos; i++) {
-        procesos_activos[i].encontrado = 0;
+    cpu_sample_generation++;
+    for (int i = 0; i < procesos_high_water; i++) {
+        proc_columns.flags[i] &= (unsigned char)~(SLOT_FOUND | SLOT_SKIPPED);
     }
 
-    // 2. Recorrer /proc y procesar cada PID
-    struct dirent *entry;
-    printf("=== CICLO DE MONITOREO ===\n");
+    // 2. Enumerar /proc y leer todas las muestras (en paralelo si está configurado)
+    monitor_log("=== CICLO DE MONITOREO ===\n");
+    if (enumerate_pids() < 0) {
+        return;
+    }
+    int enumerated = cycle_pids_count;
+    int skipped = select_due_pids(&ctx);
+    if (sample_cycle_pids() < 0) {
+        return;
+    }
+    monitor_log("[INFO] Muestreo adaptativo: %d de %d procesos leídos (%d en nivel rápido)\n",
+                enumerated - skipped, enumerated, num_fast_processes);
     
-    while ((entry = readdir(dir)) != NULL) {
-        // Verificar si el nombre del directorio es un número (PID)
-        char *endptr;
-        long lpid = strtol(entry->d_name, &endptr, 10);
-        if (*endptr == '\0') {
-            pid_t pid = (pid_t)lpid;
-
-            // Obtener información del proceso
-            ProcessInfo *info_ptr = get_process_info(pid);
-            if (!info_ptr || strlen(info_ptr->name) == 0) {
-                if (info_ptr) free(info_ptr);
-                continue;
-            }
-            
-            int idx = find_process(pid);
-            if (idx == -1) {
-                // Proceso nuevo - agregarlo
-                add_process(*info_ptr);
-                // Callback para proceso nuevo
-                if (event_callbacks && event_callbacks->on_new_process) {
-                    event_callbacks->on_new_process(info_ptr);
-                }
-            } else {
-                // Proceso existente - actualizar información y verificar alertas
-                ProcessInfo *existing = &procesos_activos[idx].info;
-                
-                // Preservar información de alertas previas
-                int prev_exceeds = existing->exceeds_thresholds;
-                time_t prev_first_exceed = existing->first_threshold_exceed;
-                int prev_alerta_activa = existing->alerta_activa;
-                time_t prev_inicio_alerta = existing->inicio_alerta;
-                
-                // Actualizar información del proceso
-                update_process(*info_ptr, idx);
-
-                // Restaurar información de alertas
-                existing->exceeds_thresholds = prev_exceeds;
-                existing->first_threshold_exceed = prev_first_exceed;
-                existing->alerta_activa = prev_alerta_activa;
-                existing->inicio_alerta = prev_inicio_alerta;
-                
-                // Verificar y actualizar estado de alerta
-                check_and_update_alert_status(existing);
-            }
-            
-            // Verificar si el proceso excede umbrales y generar alertas con callbacks
-            if (info_ptr->cpu_usage > config.max_cpu_usage) {
-                printf("[ALERTA CPU] PID: %d, Nombre: %s, CPU: %.2f%%\n",
-                       pid, info_ptr->name, info_ptr->cpu_usage);
-                if (event_callbacks && event_callbacks->on_high_cpu_alert) {
-                    event_callbacks->on_high_cpu_alert(info_ptr);
-                }
+    // 3. Fusionar las muestras en la tabla de procesos, en orden de PID
+    for (int p = 0; p < cycle_pids_count; p++) {
+        const ProcSample *sample_ptr = &cycle_samples[p];
+        if (sample_ptr->pid == 0) {
+            continue; // El proceso terminó tras la enumeración
+        }
+        ProcSample sample = *sample_ptr;
+        pid_t pid = sample.pid;
+        
+        ProcessInfo info;
+        if (fill_process_info(&ctx, &sample, &info) != 0) {
+            continue;
+        }
+        
+        int idx = find_process(pid);
+        if (idx != -1 && proc_columns.starttime[idx] != sample.starttime) {
+            // PID reutilizado: el proceso anterior terminó y este es uno nuevo,
+            // así que no debe heredar su estado de alerta
+            delta_record_slot(DELTA_REMOVED, idx, 0);
+            remove_process(idx);
+            idx = -1;
+        }
+        
+        if (should_sample_tasks(&info, idx)) {
+            sample_process_tasks(&ctx, &info);
+        }
+        
+        int is_new_process = (idx == -1);
+        if (is_new_process) {
+            // Proceso nuevo - agregarlo
+            idx = add_process(&info, sample.starttime);
+            if (idx != -1) {
+                delta_record(DELTA_ADDED, &info, 0);
             }
-            
-            if (info_ptr->mem_usage > config.max_ram_usage) {
-                printf("[ALERTA MEM] PID: %d, Nombre: %s, Mem: %.2f%%\n",
-                       pid, info_ptr->name, info_ptr->mem_usage);
-                if (event_callbacks && event_callbacks->on_high_memory_alert) {
-                    event_callbacks->on_high_memory_alert(info_ptr);
-                }
+        } else {
+            // Proceso existente - actualizar información y verificar alertas
+            refresh_process(&info, idx);
+        }
+        
+        if (idx != -1) {
+            record_process_history(&info, &sample.taken, idx);
+            update_memory_trend(idx, &sample.taken, &ctx);
+            if (config.exe_integrity && !procesos_activos[idx].exe_checked) {
+                check_process_executable(idx);
             }
-            
-            free(info_ptr);
+            schedule_next_sample(idx, &sample.taken, is_new_process);
         }
     }
-    closedir(dir);
 
-    // 3. Eliminar procesos que no fueron encontrados (terminados)
-    for (int i = num_procesos_activos - 1; i >= 0; i--) {
-        if (!procesos_activos[i].encontrado) {
-            pid_t terminated_pid = procesos_activos[i].info.pid;
-            char terminated_name[256];
-            strncpy(terminated_name, procesos_activos[i].info.name, sizeof(terminated_name) - 1);
-            terminated_name[255] = '\0';
-            
-            // Callback para proceso terminado
-            if (event_callbacks && event_callbacks->on_process_terminated) {
-                event_callbacks->on_process_terminated(terminated_pid, terminated_name);
-            }
-            
-            remove_process(terminated_pid);
+    // 4. Eliminar procesos que no fueron encontrados (terminados)
+    for (int i = 0; i < procesos_high_water; i++) {
+        if ((proc_columns.flags[i] & (SLOT_IN_USE | SLOT_FOUND)) == SLOT_IN_USE) {
+            delta_record_slot(DELTA_REMOVED, i, 0);
+            remove_process(i);
         }
     }
     
-    // 4. Mostrar estadísticas opcionales
-    show_process_stats();
-}
-
-// ===== FUNCIONES DE CONTROL DE HILOS =====
-
-void set_process_callbacks(ProcessCallbacks *callbacks) {
-    pthread_mutex_lock(&mutex);
-    event_callbacks = callbacks;
-    pthread_mutex_unlock(&mutex);
-}
-
-static void* monitoring_thread_function(void* arg) {
-    (void)arg; // Evitar warning de parámetro no usado
+    // Descartar muestras de CPU de PIDs que ya no existen
+    cpu_sample_sweep();
     
-    while (!should_stop) {
-        // Ejecutar ciclo de monitoreo
-        pthread_mutex_lock(&mutex);
-        monitor_processes();
-        pthread_mutex_unlock(&mutex);
-        
-        // Esperar el intervalo configurado
-        for (int i = 0; i < config.check_interval && !should_stop; i++) {
-            sleep(1);
-        }
-    }
+    // Consumo de cada subárbol y alertas sobre consumo repartido entre hijos
+    aggregate_process_tree();
     
-    monitoring_active = 0;
-    pthread_exit(NULL);
-    return NULL;
+    // Consumo agregado de servicios y contenedores
+    monitor_cgroups(&ctx);
+    
+    // 5. Publicar el resultado del ciclo para los lectores
+    ProcessSnapshot *snapshot = build_process_snapshot();
+    if (snapshot) {
+        show_process_stats(snapshot);
+        publish_process_snapshot(snapshot);
+    }
 }
 
-int start_monitoring(void) {
-    pthread_mutex_lock(&mutex);
+// ===== SEGUIMIENTO POR EVENTOS DEL KERNEL =====
+
+/**
+ * Registra de inmediato un proceso notificado por fork/exec, sin esperar al
+ * siguiente recorrido de /proc. En un exec el PID ya existe: se actualiza su
+ * nombre y se reporta como proceso nuevo porque ejecuta otro programa.
+ */
+static void track_process_event(pid_t pid, int is_exec) {
+    char buf[STAT_BUFFER_SIZE];
+    ProcSample sample;
+    if (read_proc_sample(pid, &sample, buf, sizeof(buf)) != 0) {
+        return; // Terminó antes de poder leerlo
+    }
     
-    if (monitoring_active) {
-        pthread_mutex_unlock(&mutex);
-        printf("[INFO] El monitoreo ya está activo\n");
-        return 1; // Ya está activo
+    CycleContext ctx;
+    if (last_cycle_ctx_valid) {
+        ctx = last_cycle_ctx;
+        clock_gettime(CLOCK_MONOTONIC, &ctx.now);
+    } else {
+        capture_cycle_context(&ctx);
     }
     
-    should_stop = 0;
-    monitoring_active = 1;
+    ProcessInfo info;
+    if (fill_process_info(&ctx, &sample, &info) != 0) {
+        return;
+    }
     
-    int result = pthread_create(&monitoring_thread, NULL, monitoring_thread_function, NULL);
-    if (result != 0) {
-        monitoring_active = 0;
-        pthread_mutex_unlock(&mutex);
-        fprintf(stderr, "[ERROR] No se pudo crear el hilo de monitoreo: %d\n", result);
-        return -1;
+    int idx = find_process(pid);
+    if (idx != -1 && proc_columns.starttime[idx] != sample.starttime) {
+        // PID reutilizado antes de recibir su exit
+        delta_record_slot(DELTA_REMOVED, idx, 0);
+        remove_process(idx);
+        idx = -1;
     }
     
-    pthread_mutex_unlock(&mutex);
-    printf("[INFO] Monitoreo iniciado con intervalo de %d segundos\n", config.check_interval);
-    return 0;
+    if (idx == -1) {
+        // Sin ranura no hay alta que notificar: no llegaría su baja
+        if (add_process(&info, sample.starttime) != -1) {
+            delta_record(DELTA_ADDED, &info, 0);
+        }
+    } else if (is_exec) {
+        ActiveProcess *existing = &procesos_activos[idx];
+        const char *name = string_pool_intern(info.name);
+        if (name) {
+            string_pool_release(existing->name);
+            existing->name = name;
+        }
+        existing->is_whitelisted = info.is_whitelisted;
+        // Otro binario: revisar su integridad en el próximo ciclo completo
+        existing->state.exe_flags = 0;
+        existing->state.exe_sha256[0] = '\0';
+        existing->exe_checked = 0;
+        monitor_log("[EXEC] PID: %d, Nombre: %s\n", pid, existing->name);
+        delta_record_slot(DELTA_ADDED, idx, 0);
+    }
 }
 
 /**
- * @brief Detiene el monitoreo de procesos de forma robusta
- * 
- * Esta función implementa una estrategia de terminación inteligente que previene
- * los colgamientos comunes durante el cierre de aplicaciones multihilo. El problema
- * típico ocurre cuando pthread_join() se bloquea indefinidamente esperando por un
- * hilo que no responde, causando que toda la aplicación se "congele" al intentar salir.
- * 
- * ESTRATEGIA DE TERMINACIÓN ROBUSTA:
- * 1. Señalización limpia: Informa al hilo que debe terminar (should_stop = 1)
- * 2. Espera activa con timeout: Verifica periódicamente si el hilo terminó (3 segundos máximo)
- * 3. Terminación forzada: Si no responde, marca forzadamente como inactivo
- * 4. Join final: Permite que pthread_join complete si es posible, pero sin bloqueo indefinido
- * 
- * Esta aproximación garantiza que la aplicación nunca se cuelgue al cerrar, permitiendo
- * al usuario salir limpiamente incluso si hay hilos problemáticos.
+ * Indica si al grupo de hilos le quedan hilos además del líder. Cuando el
+ * líder termina con otros hilos vivos, /proc/[tgid] sigue existiendo (el
+ * líder queda zombi) y num_threads los sigue contando; cuando termina el
+ * proceso entero, el evento de salida del líder llega con num_threads en 1
+ * o con /proc/[tgid] ya liberado.
  * 
- * @return 0 si se detuvo correctamente, 1 si no estaba activo, -1 si error
+ * @return int: 1 si el proceso sigue en ejecución, 0 si terminó
  */
-int stop_monitoring(void) {
+static int thread_group_alive(pid_t tgid) {
+    int pid_fd = open_pid_dir(tgid);
+    if (pid_fd < 0) return 0;
+    char buf[STAT_BUFFER_SIZE];
+    ssize_t len = read_file_at(pid_fd, "stat", buf, sizeof(buf));
+    close(pid_fd);
+    if (len < 0) return 0;
+    
+    char *p = strrchr(buf, ')');
+    if (!p) return 0;
+    p++;
+    while (*p == ' ') p++;
+    if (*p == '\0') return 0;
+    p++;  // Campo 3 (state)
+    
+    // Campos 4 a 20 (num_threads)
+    long long value = 0;
+    for (int field = 4; field <= 20; field++) {
+        char *end;
+        value = strtoll(p, &end, 10);
+        if (end == p) return 0;
+        p = end;
+    }
+    return value > 1;
+}
+
+/**
+ * Manejador del conector de procesos. Se ejecuta en el hilo del conector y
+ * toma el mutex global igual que el ciclo de monitoreo.
+ */
+static void on_proc_connector_event(ProcConnectorEvent event, pid_t pid) {
     pthread_mutex_lock(&mutex);
     
-    if (!monitoring_active) {
-        pthread_mutex_unlock(&mutex);
-        printf("[INFO] El monitoreo no está activo\n");
-        return 1; // No estaba activo
+    if (!should_stop) {
+        int pending_before = delta_entry_count();
+        
+        if (event == PROC_CONN_EXIT) {
+            // Si solo terminó el hilo líder, el proceso sigue vivo: quitarlo
+            // aquí perdería su estado de alertas y tendencia al reaparecer
+            int idx = find_process(pid);
+            if (idx != -1 && !thread_group_alive(pid)) {
+                delta_record_slot(DELTA_REMOVED, idx, 0);
+                remove_process(idx);
+            }
+        } else {
+            track_process_event(pid, event == PROC_CONN_EXEC);
+        }
+        
+        // Los eventos se agrupan: el hilo de monitoreo entrega el diff en su
+        // plazo rápido fijo en lugar de esperar al próximo ciclo completo.
+        // Solo se le despierta para armar ese plazo o, durante una ráfaga de
+        // fork/exec, cuando el diff acumulado alcanza DELTA_FLUSH_MAX_ENTRIES.
+        int pending_after = delta_entry_count();
+        if (monitor_wakeup_ready && pending_after > pending_before &&
+            (pending_before == 0 || pending_after >= DELTA_FLUSH_MAX_ENTRIES)) {
+            pthread_cond_signal(&monitor_wakeup);
+        }
     }
     
-    should_stop = 1;
     pthread_mutex_unlock(&mutex);
+}
+
+// ===== MONITOREO DE CGROUPS =====
+
+/**
+ * Lee los cgroups configurados y aplica la misma lógica de umbrales y
+ * duración de alerta que a un proceso, con los mismos callbacks. Una lectura
+ * por archivo del cgroup sustituye a sumar los datos de todos sus PIDs.
+ */
+static void monitor_cgroups(const CycleContext *ctx) {
+    if (!cgroups_configured) {
+        cgroups_configured = 1;
+        if (config.num_cgroups == 0 ||
+            cgroup_monitor_configure(config.cgroup_paths, config.num_cgroups) != 0) {
+            return;
+        }
+        
+        num_cgroup_infos = cgroup_monitor_count();
+        cgroup_infos = calloc((size_t)num_cgroup_infos, sizeof(ProcessInfo));
+        cgroup_samples = calloc((size_t)num_cgroup_infos, sizeof(CgroupSample));
+        if (!cgroup_infos || !cgroup_samples) {
+            fprintf(stderr, "[ERROR] No se pudo asignar memoria para el estado de los cgroups\n");
+            clear_cgroup_state();
+            return;
+        }
+        
+        for (int i = 0; i < num_cgroup_infos; i++) {
+            cgroup_infos[i].pid = -(i + 1);
+            cgroup_infos[i].is_cgroup = 1;
+            strncpy(cgroup_infos[i].name, config.cgroup_paths[i], sizeof(cgroup_infos[i].name) - 1);
+        }
+    }
     
-    printf("[INFO] Esperando terminación del hilo de monitoreo...\n");
-      // IMPLEMENTACIÓN DEL TIMEOUT: En lugar de usar pthread_join() directamente
-    // (que puede bloquear indefinidamente), verificamos periódicamente el estado
-    // del hilo. Esto permite detectar si el hilo no responde y tomar medidas correctivas.
-    int timeout_seconds = 3;
-    int attempts = 0;
+    if (num_cgroup_infos == 0) return;
     
-    while (attempts < timeout_seconds) {
-        pthread_mutex_lock(&mutex);
+    cgroup_monitor_sample(cgroup_samples);
+    
+    for (int i = 0; i < num_cgroup_infos; i++) {
+        ProcessInfo *info = &cgroup_infos[i];
+        const CgroupSample *sample = &cgroup_samples[i];
+        
+        if (!sample->valid) {
+            // El cgroup no existe (servicio detenido): no puede seguir en alerta
+            info->cpu_usage = 0.0f;
+            info->mem_usage = 0.0f;
+            info->rss_kb = 0;
+            info->io_kbps = 0.0f;
+            clear_alert_if_needed(info);
+            continue;
+        }
+        
+        info->cpu_usage = sample->cpu_usage;
+        info->rss_kb = sample->memory_kb;
+        info->mem_usage = ctx->mem_total_kb ?
+            (float)(100.0 * sample->memory_kb / (double)ctx->mem_total_kb) : 0.0f;
+        info->io_kbps = sample->io_kbps;
+        
+        check_and_update_alert_status(info);
+    }
+}
+
+static void clear_cgroup_state(void) {
+    free(cgroup_infos);
+    free(cgroup_samples);
+    cgroup_infos = NULL;
+    cgroup_samples = NULL;
+    num_cgroup_infos = 0;
+    cgroups_configured = 0;
+    cgroup_monitor_cleanup();
+}
+
+// ===== PRESIÓN DEL SISTEMA (PSI) =====
+
+/**
+ * Lee /proc/pressure al inicio de cada ciclo completo. El nivel del regulador
+ * decide cuánto se estiran los intervalos y si se omiten las lecturas
+ * profundas (PSS, hilos). Un recurso cuyo some avg10 se mantiene sobre
+ * pressure_threshold durante alert_duration levanta una alerta de presión,
+ * que se despeja por debajo de la banda de histéresis.
+ */
+static void update_system_pressure(void) {
+    if (config.pressure_threshold <= 0.0f) {
+        // Desactivado: las alertas activas se despejan en la próxima entrega
+        pressure_state.cleared |= pressure_state.stalled;
+        pressure_state.stalled = 0;
+        pressure_state.level = LOAD_LEVEL_NORMAL;
+        return;
+    }
+    
+    int available = pressure_update(&pressure_state.last) == 0;
+    if (available != pressure_state.available) {
+        if (!available) {
+            monitor_log("[INFO] El kernel no expone /proc/pressure: sin autorregulación por presión\n");
+        }
+        pressure_state.available = available;
+    }
+    if (!available) {
+        pressure_state.level = LOAD_LEVEL_NORMAL;
+        return;
+    }
+    
+    LoadLevel level = pressure_state.last.level;
+    if (level != pressure_state.level) {
+        monitor_log("[INFO] Autorregulación: presión %s (some avg10 máx. %.1f%%), intervalos x%d%s\n",
+                    pressure_level_name(level), pressure_state.last.peak_avg10,
+                    pressure_interval_factor(level),
+                    level == LOAD_LEVEL_NORMAL ? "" : ", sin lecturas de PSS ni de hilos");
+        pressure_state.level = level;
+    }
+    
+    time_t now = time(NULL);
+    for (int r = 0; r < PSI_RESOURCE_COUNT; r++) {
+        unsigned int bit = 1u << r;
+        const PsiStats *stats = &pressure_state.last.resources[r];
+        float value = stats->available ? stats->some.avg10 : 0.0f;
+        
+        if (pressure_state.stalled & bit) {
+            if (value < config.pressure_threshold * config.alert_hysteresis) {
+                pressure_state.stalled &= ~bit;
+                pressure_state.cleared |= bit;
+                monitor_log("[ALERTA PRESIÓN DESPEJADA] Recurso: %s, some avg10: %.1f%%\n",
+                            pressure_resource_name((PsiResource)r), value);
+            }
+            continue;
+        }
+        
+        if (value < config.pressure_threshold) {
+            pressure_state.first_exceed[r] = 0;
+            continue;
+        }
+        if (pressure_state.first_exceed[r] == 0) {
+            pressure_state.first_exceed[r] = now;
+        }
+        if (now - pressure_state.first_exceed[r] >= config.alert_duration) {
+            monitor_log("[ALERTA PRESIÓN] Recurso: %s, Duración: %d seg, some avg10: %.1f%%, "
+                        "avg60: %.1f%%, full avg10: %.1f%%\n",
+                        pressure_resource_name((PsiResource)r), (int)(now - pressure_state.first_exceed[r]),
+                        value, stats->some.avg60, stats->full.avg10);
+            pressure_state.stalled |= bit;
+            pressure_state.raised |= bit;
+            pressure_state.first_exceed[r] = 0;
+        }
+    }
+}
+
+// ===== ÁRBOL DE PROCESOS =====
+
+/**
+ * Desengancha un proceso de la lista de hijos de su padre
+ */
+static void tree_detach(int idx) {
+    ActiveProcess *p = &procesos_activos[idx];
+    if (p->parent_slot >= 0) {
+        if (p->prev_sibling >= 0) {
+            procesos_activos[p->prev_sibling].next_sibling = p->next_sibling;
+        } else {
+            procesos_activos[p->parent_slot].first_child = p->next_sibling;
+        }
+        if (p->next_sibling >= 0) {
+            procesos_activos[p->next_sibling].prev_sibling = p->prev_sibling;
+        }
+    }
+    p->parent_slot = -1;
+    p->prev_sibling = -1;
+    p->next_sibling = -1;
+}
+
+/**
+ * Enlaza un proceso bajo la ranura de su padre según el ppid de la última
+ * muestra. Solo cambia algo si el padre es otro: adopción por init o por
+ * un subreaper, o un hijo que se registró antes que su padre.
+ */
+static void tree_update_parent(int idx) {
+    ActiveProcess *p = &procesos_activos[idx];
+    pid_t ppid = p->ppid;
+    int parent = ppid > 0 ? find_process(ppid) : -1;
+    if (parent == idx) parent = -1;
+    if (parent == p->parent_slot) return;
+    
+    tree_detach(idx);
+    if (parent < 0) return;
+    
+    p->parent_slot = parent;
+    p->next_sibling = procesos_activos[parent].first_child;
+    if (p->next_sibling >= 0) {
+        procesos_activos[p->next_sibling].prev_sibling = idx;
+    }
+    procesos_activos[parent].first_child = idx;
+}
+
+/**
+ * Saca del árbol un proceso terminado. Sus hijos quedan como raíces hasta
+ * que su próxima muestra traiga el ppid del proceso que los adoptó.
+ */
+static void tree_remove(int idx) {
+    tree_detach(idx);
+    int child = procesos_activos[idx].first_child;
+    while (child >= 0) {
+        int next = procesos_activos[child].next_sibling;
+        procesos_activos[child].parent_slot = -1;
+        procesos_activos[child].prev_sibling = -1;
+        procesos_activos[child].next_sibling = -1;
+        child = next;
+    }
+    procesos_activos[idx].first_child = -1;
+}
+
+static int subtree_exceeds(float cpu_usage, float mem_usage, float fraction) {
+    return (config.subtree_max_cpu > 0 && cpu_usage > config.subtree_max_cpu * fraction) ||
+           (config.subtree_max_ram > 0 && mem_usage > config.subtree_max_ram * fraction);
+}
+
+/**
+ * Alerta sobre el subárbol mínimo que supera los umbrales de subárbol: el
+ * consumo repartido entre los descendientes de un proceso cuando ninguno
+ * de sus subárboles hijos ni el propio proceso bastan por sí solos. Así se
+ * señala al padre de un fork-bomb o de un minero con workers, no a todos
+ * sus ancestros. Usa la misma duración sostenida que las demás alertas.
+ */
+static void check_subtree_alert(int idx, int exceeds) {
+    ActiveProcess *p = &procesos_activos[idx];
+    ProcessState *state = &p->state;
+    
+    // Un subárbol pendiente o en alerta se mantiene hasta bajar de la banda de salida
+    if (p->subtree_exceeds_since != 0 || state->subtree_alert) {
+        exceeds = subtree_exceeds(state->subtree_cpu_usage, state->subtree_mem_usage,
+                                  config.alert_hysteresis);
+    }
+    int candidate = exceeds && !p->subtree_child_exceeds &&
+                    !subtree_exceeds(proc_columns.cpu_usage[idx], proc_columns.mem_usage[idx], 1.0f) &&
+                    state->subtree_processes > 1 && !p->is_whitelisted;
+    
+    if (!candidate) {
+        p->subtree_exceeds_since = 0;
+        if (state->subtree_alert) {
+            state->subtree_alert = 0;
+            if (alert_forget_notification(state, ALERT_KIND_SUBTREE)) {
+                monitor_log("[ALERTA SUBÁRBOL DESPEJADA] PID: %d, Nombre: %s, Procesos: %d, CPU: %.2f%%, MEM: %.2f%%\n",
+                            proc_columns.pid[idx], p->name, state->subtree_processes,
+                            state->subtree_cpu_usage, state->subtree_mem_usage);
+                delta_record_slot(DELTA_ALERT_CLEARED, idx, ALERT_KIND_SUBTREE);
+            }
+        }
+        return;
+    }
+    
+    time_t current_time = time(NULL);
+    if (p->subtree_exceeds_since == 0) {
+        p->subtree_exceeds_since = current_time;
+        return;
+    }
+    
+    int duration = (int)(current_time - p->subtree_exceeds_since);
+    if (duration >= config.alert_duration) {
+        state->subtree_alert = 1;
+    }
+    if (state->subtree_alert && alert_may_notify(state, ALERT_KIND_SUBTREE, current_time)) {
+        monitor_log("[ALERTA SUBÁRBOL] PID: %d, Nombre: %s, Procesos: %d, Duración: %d seg, "
+                    "CPU: %.2f%%, MEM: %.2f%%, RSS: %lu kB\n",
+                    proc_columns.pid[idx], p->name, state->subtree_processes, duration,
+                    state->subtree_cpu_usage, state->subtree_mem_usage, state->subtree_rss_kb);
+        delta_record_slot(DELTA_ALERT_RAISED, idx, ALERT_KIND_SUBTREE);
+    }
+}
+
+/**
+ * Suma CPU, RAM y RSS de cada subárbol y evalúa sus alertas en una sola
+ * pasada. Se construye el orden en anchura desde las raíces; recorrerlo al
+ * revés visita cada proceso después de todos sus descendientes, así que
+ * basta con sumar cada subárbol terminado en el de su padre.
+ */
+static void aggregate_process_tree(void) {
+    if (tree_order_capacity < procesos_high_water) {
+        int *temp = realloc(tree_order, (size_t)procesos_capacidad * sizeof(int));
+        if (!temp) {
+            fprintf(stderr, "[ERROR] No se pudo asignar memoria para el árbol de procesos\n");
+            return;
+        }
+        tree_order = temp;
+        tree_order_capacity = procesos_capacidad;
+    }
+    
+    int n = 0;
+    for (int i = 0; i < procesos_high_water; i++) {
+        if (!(proc_columns.flags[i] & SLOT_IN_USE)) continue;
+        ProcessState *state = &procesos_activos[i].state;
+        state->subtree_cpu_usage = proc_columns.cpu_usage[i];
+        state->subtree_mem_usage = proc_columns.mem_usage[i];
+        state->subtree_rss_kb = procesos_activos[i].rss_kb;
+        state->subtree_processes = 1;
+        procesos_activos[i].subtree_child_exceeds = 0;
+        if (procesos_activos[i].parent_slot < 0) {
+            tree_order[n++] = i;
+        }
+    }
+    
+    for (int k = 0; k < n; k++) {
+        for (int child = procesos_activos[tree_order[k]].first_child;
+             child >= 0 && n < procesos_high_water;
+             child = procesos_activos[child].next_sibling) {
+            tree_order[n++] = child;
+        }
+    }
+    
+    int alerts_enabled = config.subtree_max_cpu > 0 || config.subtree_max_ram > 0;
+    for (int k = n - 1; k >= 0; k--) {
+        ActiveProcess *p = &procesos_activos[tree_order[k]];
+        const ProcessState *state = &p->state;
+        
+        int exceeds = subtree_exceeds(state->subtree_cpu_usage, state->subtree_mem_usage, 1.0f);
+        if (alerts_enabled) {
+            check_subtree_alert(tree_order[k], exceeds);
+        }
+        
+        if (p->parent_slot >= 0) {
+            ActiveProcess *parent = &procesos_activos[p->parent_slot];
+            parent->state.subtree_cpu_usage += state->subtree_cpu_usage;
+            parent->state.subtree_mem_usage += state->subtree_mem_usage;
+            parent->state.subtree_rss_kb += state->subtree_rss_kb;
+            parent->state.subtree_processes += state->subtree_processes;
+            parent->subtree_child_exceeds |= exceeds;
+        }
+    }
+}
+
+// ===== FUNCIONES DE CONTROL DE HILOS =====
+
+void set_process_callbacks(ProcessCallbacks *callbacks) {
+    pthread_mutex_lock(&mutex);
+    event_callbacks = callbacks;
+    pthread_mutex_unlock(&mutex);
+}
+
+static void timespec_add_ms(struct timespec *ts, long ms) {
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static int timespec_before(const struct timespec *a, const struct timespec *b) {
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+/**
+ * Hilo de monitoreo. Entre ciclos completos espera con timeout absoluto sobre
+ * CLOCK_MONOTONIC; si hay procesos en el nivel rápido o diferencias del
+ * conector pendientes, despierta en un plazo fijo cada fast_interval_ms para
+ * muestrearlos y entregarlas. El mutex global solo se libera durante la
+ * espera.
+ */
+static void* monitoring_thread_function(void* arg) {
+    (void)arg; // Evitar warning de parámetro no usado
+    
+    // Plazo absoluto de la próxima pasada rápida. Solo avanza cuando se
+    // cumple, así que los despertares por eventos no lo posponen.
+    struct timespec next_fast = {0, 0};
+    int fast_armed = 0;
+    
+    // Diff en entrega: propio de este hilo, se reutiliza entre entregas
+    DeltaBatch batch;
+    memset(&batch, 0, sizeof(DeltaBatch));
+    
+    pthread_mutex_lock(&mutex);
+    while (!should_stop) {
+        // Ejecutar ciclo de monitoreo y entregar su diff sin el mutex
+        monitor_cycle();
+        hand_off_process_delta(&batch);
+        
+        struct timespec cycle_end;
+        clock_gettime(CLOCK_MONOTONIC, &cycle_end);
+        
+        while (!should_stop) {
+            // Recalcular en cada vuelta: set_monitoring_interval() puede cambiarlo.
+            // Con el sistema bajo presión los ciclos se espacian.
+            int factor = pressure_interval_factor(pressure_state.level);
+            long fast_ms = (long)config.fast_interval_ms * factor;
+            struct timespec next_cycle = cycle_end;
+            timespec_add_ms(&next_cycle, (long)config.check_interval * 1000 * factor);
+            
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if (!timespec_before(&now, &next_cycle)) {
+                break;
+            }
+            
+            // Una ráfaga del conector se entrega sin esperar el plazo
+            if (delta_entry_count() >= DELTA_FLUSH_MAX_ENTRIES) {
+                hand_off_process_delta(&batch);
+                continue;
+            }
+            
+            if (num_fast_processes == 0 && !delta_pending()) {
+                fast_armed = 0;
+            } else if (!fast_armed) {
+                next_fast = now;
+                timespec_add_ms(&next_fast, fast_ms);
+                fast_armed = 1;
+            }
+            
+            // La pasada rápida corre al vencer el plazo, haya despertado la
+            // espera por timeout o por una señal
+            if (fast_armed && !timespec_before(&now, &next_fast)) {
+                if (num_fast_processes > 0) {
+                    sample_fast_processes();
+                }
+                hand_off_process_delta(&batch);
+                
+                timespec_add_ms(&next_fast, fast_ms);
+                if (timespec_before(&next_fast, &now)) {
+                    // La pasada se atrasó más de un intervalo: no recuperar en ráfaga
+                    next_fast = now;
+                    timespec_add_ms(&next_fast, fast_ms);
+                }
+                continue;
+            }
+            
+            struct timespec deadline = next_cycle;
+            if (fast_armed && timespec_before(&next_fast, &deadline)) {
+                deadline = next_fast;
+            }
+            pthread_cond_timedwait(&monitor_wakeup, &mutex, &deadline);
+        }
+    }
+    
+    monitoring_active = 0;
+    pthread_mutex_unlock(&mutex);
+    free_delta_batch(&batch);
+    return NULL;
+}
+
+/**
+ * Pasada rápida entre ciclos completos: vuelve a leer solo los procesos del
+ * nivel rápido para seguir su CPU% y sus alertas con resolución sub-segundo.
+ * Debe llamarse con el mutex global tomado.
+ */
+static void sample_fast_processes(void) {
+    if (!last_cycle_ctx_valid) return;
+    
+    CycleContext ctx = last_cycle_ctx;
+    clock_gettime(CLOCK_MONOTONIC, &ctx.now);
+    
+    char buf[STAT_BUFFER_SIZE];
+    int sampled = 0;
+    // El recorrido solo lee la columna de estado: el nivel rápido suele ser
+    // una fracción pequeña de las ranuras y se repite cada fast_interval_ms
+    for (int i = 0; i < procesos_high_water; i++) {
+        if (!(proc_columns.flags[i] & SLOT_FAST)) {
+            continue;
+        }
+        
+        pid_t pid = proc_columns.pid[i];
+        int pid_fd = open_pid_dir(pid);
+        if (pid_fd < 0) {
+            continue;
+        }
+        
+        ProcSample sample;
+        ProcessInfo info;
+        int read_ok = read_proc_sample_at(pid_fd, pid, &sample, buf, sizeof(buf)) == 0;
+        if (read_ok) {
+            classify_sample_at(pid_fd, &sample);
+            read_proc_io_at(pid_fd, &sample, buf, sizeof(buf));
+            read_proc_pss_at(pid_fd, &sample, &ctx);
+        }
+        close(pid_fd);
+        
+        if (!read_ok || sample.starttime != proc_columns.starttime[i] ||
+            fill_process_info(&ctx, &sample, &info) != 0) {
+            continue; // Terminó o fue reemplazado: lo resuelve el próximo ciclo completo
+        }
+        
+        if (should_sample_tasks(&info, i)) {
+            sample_process_tasks(&ctx, &info);
+        }
+        
+        refresh_process(&info, i);
+        record_process_history(&info, &sample.taken, i);
+        update_memory_trend(i, &sample.taken, &ctx);
+        schedule_next_sample(i, &sample.taken, 0);
+        sampled++;
+    }
+    
+    if (sampled > 0) {
+        ProcessSnapshot *snapshot = build_process_snapshot();
+        if (snapshot) {
+            publish_process_snapshot(snapshot);
+        }
+    }
+}
+
+/**
+ * Activa o desactiva el muestreo de alta frecuencia de un proceso. Mientras
+ * esté activo, el proceso se relee cada fast_interval_ms entre ciclos.
+ * 
+ * @param pid: PID de un proceso ya monitoreado
+ * @param enabled: 1 para activar, 0 para desactivar
+ * @return int: 0 si es exitoso, -1 si el proceso no está siendo monitoreado
+ */
+int set_process_investigation(pid_t pid, int enabled) {
+    pthread_mutex_lock(&mutex);
+    
+    int idx = find_process(pid);
+    if (idx == -1) {
+        pthread_mutex_unlock(&mutex);
+        return -1;
+    }
+    
+    enabled = enabled ? 1 : 0;
+    if (procesos_activos[idx].investigated != enabled) {
+        procesos_activos[idx].investigated = enabled;
+        // Al desactivarla, el nivel se recalcula en la próxima lectura
+        if (enabled) {
+            set_sampling_tier(idx, SAMPLE_TIER_FAST);
+        }
+        if (monitor_wakeup_ready) {
+            pthread_cond_signal(&monitor_wakeup); // Adoptar el nuevo plazo de espera
+        }
+        printf("[INFO] PID %d: muestreo de alta frecuencia %s (%d ms)\n", pid,
+               enabled ? "activado" : "desactivado", config.fast_interval_ms);
+    }
+    
+    pthread_mutex_unlock(&mutex);
+    return 0;
+}
+
+int start_monitoring(void) {
+    pthread_mutex_lock(&mutex);
+    
+    if (monitoring_active) {
+        pthread_mutex_unlock(&mutex);
+        printf("[INFO] El monitoreo ya está activo\n");
+        return 1; // Ya está activo
+    }
+    
+    should_stop = 0;
+    monitoring_active = 1;
+    
+    if (!monitor_wakeup_ready) {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&monitor_wakeup, &attr);
+        pthread_condattr_destroy(&attr);
+        monitor_wakeup_ready = 1;
+    }
+    
+    int result = pthread_create(&monitoring_thread, NULL, monitoring_thread_function, NULL);
+    if (result != 0) {
+        monitoring_active = 0;
+        pthread_mutex_unlock(&mutex);
+        fprintf(stderr, "[ERROR] No se pudo crear el hilo de monitoreo: %d\n", result);
+        return -1;
+    }
+    
+    pthread_mutex_unlock(&mutex);
+    printf("[INFO] Monitoreo iniciado con intervalo de %d segundos\n", config.check_interval);
+    
+    // Backend opcional por eventos; si no hay CAP_NET_ADMIN se sigue con sondeo
+    if (config.use_proc_connector && proc_connector_start(on_proc_connector_event) < 0) {
+        printf("[INFO] Seguimiento de procesos por sondeo periódico de /proc\n");
+    }
+    return 0;
+}
+
+/**
+ * @brief Detiene el monitoreo de procesos de forma robusta
+ * 
+ * Esta función implementa una estrategia de terminación inteligente que previene
+ * los colgamientos comunes durante el cierre de aplicaciones multihilo. El problema
+ * típico ocurre cuando pthread_join() se bloquea indefinidamente esperando por un
+ * hilo que no responde, causando que toda la aplicación se "congele" al intentar salir.
+ * 
+ * ESTRATEGIA DE TERMINACIÓN ROBUSTA:
+ * 1. Señalización limpia: Informa al hilo que debe terminar (should_stop = 1)
+ * 2. Espera activa con timeout: Verifica periódicamente si el hilo terminó (3 segundos máximo)
+ * 3. Terminación forzada: Si no responde, marca forzadamente como inactivo
+ * 4. Join final: Permite que pthread_join complete si es posible, pero sin bloqueo indefinido
+ * 
+ * Esta aproximación garantiza que la aplicación nunca se cuelgue al cerrar, permitiendo
+ * al usuario salir limpiamente incluso si hay hilos problemáticos.
+ * 
+ * @return 0 si se detuvo correctamente, 1 si no estaba activo, -1 si error
+ */
+int stop_monitoring(void) {
+    pthread_mutex_lock(&mutex);
+    
+    if (!monitoring_active) {
+        pthread_mutex_unlock(&mutex);
+        printf("[INFO] El monitoreo no está activo\n");
+        return 1; // No estaba activo
+    }
+    
+    should_stop = 1;
+    pthread_cond_signal(&monitor_wakeup);
+    pthread_mutex_unlock(&mutex);
+    
+    // Detener primero el conector: su manejador toma el mutex global
+    proc_connector_stop();
+    exe_integrity_stop();
+    
+    printf("[INFO] Esperando terminación del hilo de monitoreo...\n");
+      // IMPLEMENTACIÓN DEL TIMEOUT: En lugar de usar pthread_join() directamente
+    // (que puede bloquear indefinidamente), verificamos periódicamente el estado
+    // del hilo. Esto permite detectar si el hilo no responde y tomar medidas correctivas.
+    int timeout_seconds = 3;
+    int attempts = 0;
+    
+    while (attempts < timeout_seconds) {
+        pthread_mutex_lock(&mutex);
         int still_active = monitoring_active;
         pthread_mutex_unlock(&mutex);
         
@@ -544,10 +1599,8 @@ int stop_monitoring(void) {
 }
 
 int is_monitoring_active(void) {
-    pthread_mutex_lock(&mutex);
-    int active = monitoring_active;
-    pthread_mutex_unlock(&mutex);
-    return active;
+    // Lectura de un entero volatile: no espera a que termine el ciclo en curso
+    return monitoring_active;
 }
 
 void set_monitoring_interval(int seconds) {
@@ -556,6 +1609,9 @@ void set_monitoring_interval(int seconds) {
     
     pthread_mutex_lock(&mutex);
     config.check_interval = seconds;
+    if (monitor_wakeup_ready) {
+        pthread_cond_signal(&monitor_wakeup); // Aplicar el intervalo sin esperar al anterior
+    }
     pthread_mutex_unlock(&mutex);
     
     printf("[INFO] Intervalo de monitoreo cambiado a %d segundos\n", seconds);
@@ -564,45 +1620,239 @@ void set_monitoring_interval(int seconds) {
 MonitoringStats get_monitoring_stats(void) {
     MonitoringStats stats = {0};
     
-    pthread_mutex_lock(&mutex);
-    
-    stats.total_processes = num_procesos_activos;
     stats.is_active = monitoring_active;
     stats.check_interval = config.check_interval;
     
-    // Contar alertas activas
-    for (int i = 0; i < num_procesos_activos; i++) {
-        ProcessInfo *p = &procesos_activos[i].info;
-        if (p->cpu_usage > config.max_cpu_usage) stats.high_cpu_count++;
-        if (p->mem_usage > config.max_ram_usage) stats.high_memory_count++;
-        if (p->alerta_activa) stats.active_alerts++;
+    // Los conteos ya vienen calculados en el snapshot del último ciclo
+    const ProcessSnapshot *snapshot = acquire_process_snapshot();
+    if (snapshot) {
+        stats.total_processes = snapshot->count;
+        stats.high_cpu_count = snapshot->high_cpu_count;
+        stats.high_memory_count = snapshot->high_memory_count;
+        stats.high_io_count = snapshot->high_io_count;
+        stats.active_alerts = snapshot->active_alerts;
+        release_process_snapshot(snapshot);
     }
     
-    pthread_mutex_unlock(&mutex);
-    
     return stats;
 }
 
 ProcessInfo* get_process_list_copy(int *count) {
-    pthread_mutex_lock(&mutex);
+    *count = 0;
     
-    *count = num_procesos_activos;
-    if (num_procesos_activos == 0) {
-        pthread_mutex_unlock(&mutex);
+    const ProcessSnapshot *snapshot = acquire_process_snapshot();
+    if (!snapshot) {
         return NULL;
     }
     
-    ProcessInfo *copy = malloc(num_procesos_activos * sizeof(ProcessInfo));
-    if (copy) {
-        for (int i = 0; i < num_procesos_activos; i++) {
-            copy[i] = procesos_activos[i].info;
+    ProcessInfo *copy = NULL;
+    if (snapshot->count > 0) {
+        copy = malloc((size_t)snapshot->count * sizeof(ProcessInfo));
+        if (copy) {
+            memcpy(copy, snapshot->processes, (size_t)snapshot->count * sizeof(ProcessInfo));
+            *count = snapshot->count;
         }
     }
     
-    pthread_mutex_unlock(&mutex);
+    release_process_snapshot(snapshot);
+    return copy;
+}
+
+/**
+ * Copia el estado de los cgroups vigilados en el último snapshot
+ * 
+ * @param count: Número de cgroups copiados
+ * @return ProcessInfo*: Array que el llamador debe liberar, o NULL si no hay
+ */
+ProcessInfo* get_cgroup_list_copy(int *count) {
+    *count = 0;
+    
+    const ProcessSnapshot *snapshot = acquire_process_snapshot();
+    if (!snapshot) {
+        return NULL;
+    }
+    
+    ProcessInfo *copy = NULL;
+    if (snapshot->cgroup_count > 0) {
+        copy = malloc((size_t)snapshot->cgroup_count * sizeof(ProcessInfo));
+        if (copy) {
+            memcpy(copy, snapshot->cgroups, (size_t)snapshot->cgroup_count * sizeof(ProcessInfo));
+            *count = snapshot->cgroup_count;
+        }
+    }
+    
+    release_process_snapshot(snapshot);
     return copy;
 }
 
+/**
+ * Obtiene el último snapshot publicado sin esperar al ciclo de monitoreo.
+ * El snapshot es inmutable y sigue siendo válido hasta que se libere con
+ * release_process_snapshot(), aunque se publiquen otros mientras tanto.
+ * 
+ * @return const ProcessSnapshot*: Snapshot actual, o NULL si aún no hay ninguno
+ */
+const ProcessSnapshot* acquire_process_snapshot(void) {
+    pthread_mutex_lock(&snapshot_lock);
+    ProcessSnapshot *snapshot = published_snapshot;
+    if (snapshot) {
+        __sync_add_and_fetch(&snapshot->refcount, 1);
+    }
+    pthread_mutex_unlock(&snapshot_lock);
+    return snapshot;
+}
+
+void release_process_snapshot(const ProcessSnapshot *snapshot) {
+    if (!snapshot) return;
+    
+    ProcessSnapshot *s = (ProcessSnapshot *)snapshot;
+    if (__sync_sub_and_fetch(&s->refcount, 1) == 0) {
+        free(s->processes);
+        free(s->cgroups);
+        free(s);
+    }
+}
+
+/**
+ * Copia la serie histórica de un proceso (de la muestra más antigua a la
+ * más reciente). No toma el mutex global: el historial tiene su propio lock.
+ * 
+ * @param pid: PID del proceso
+ * @param out: Buffer de salida
+ * @param max_points: Capacidad del buffer
+ * @return int: Puntos copiados, o -1 si el proceso no tiene historial
+ */
+int get_process_history(pid_t pid, ProcessHistoryPoint *out, int max_points) {
+    return history_get_series(pid, out, max_points);
+}
+
+/**
+ * Copia los N procesos que más consumen según una métrica, de mayor a menor.
+ * El ranking ya viene calculado en el último snapshot, así que el coste es
+ * O(N) y no hace falta copiar la lista completa de procesos.
+ * 
+ * @param metric: TOP_BY_CPU, TOP_BY_RSS o TOP_BY_IO
+ * @param out: Buffer de salida
+ * @param n: Capacidad del buffer (como máximo PROCESS_TOP_K)
+ * @return int: Procesos copiados, o -1 si la métrica no es válida
+ */
+int get_top_processes(ProcessTopMetric metric, ProcessInfo *out, int n) {
+    if (metric < 0 || metric >= TOP_METRIC_COUNT || !out || n < 0) return -1;
+    
+    const ProcessSnapshot *snapshot = acquire_process_snapshot();
+    if (!snapshot) return 0;
+    
+    int count = snapshot->top_count[metric] < n ? snapshot->top_count[metric] : n;
+    for (int i = 0; i < count; i++) {
+        out[i] = snapshot->processes[snapshot->top[metric][i]];
+    }
+    
+    release_process_snapshot(snapshot);
+    return count;
+}
+
+typedef struct {
+    pid_t ppid;
+    int index;
+} ParentIndexEntry;
+
+static int compare_parent_index(const void *a, const void *b) {
+    pid_t pa = ((const ParentIndexEntry *)a)->ppid;
+    pid_t pb = ((const ParentIndexEntry *)b)->ppid;
+    return (pa > pb) - (pa < pb);
+}
+
+/**
+ * Copia la lectura de presión del sistema del último snapshot publicado
+ * 
+ * @param out: Lectura de PSI con el nivel del regulador
+ * @param stalled: Recursos (1 << PsiResource) con alerta de presión activa (puede ser NULL)
+ * @return int: 0 si es exitoso, -1 si el kernel no expone PSI o aún no se leyó
+ */
+int get_system_pressure(SystemPressure *out, unsigned int *stalled) {
+    // Viaja en el snapshot: no espera a que el ciclo en curso suelte el mutex
+    const ProcessSnapshot *snapshot = acquire_process_snapshot();
+    int available = snapshot && snapshot->pressure_available;
+    if (available) {
+        *out = snapshot->pressure;
+    }
+    if (stalled) {
+        *stalled = available ? snapshot->stalled : 0;
+    }
+    release_process_snapshot(snapshot);
+    return available ? 0 : -1;
+}
+
+/**
+ * Copia un proceso y todos sus descendientes del último snapshot, en orden
+ * en anchura con la raíz primero. Cada entrada conserva su ppid y los
+ * agregados de su subárbol, de modo que la GUI puede reconstruir el árbol.
+ * 
+ * @param root: PID de la raíz del subárbol
+ * @param count: Número de procesos copiados
+ * @return ProcessInfo*: Array que el llamador debe liberar, o NULL si la raíz no existe
+ */
+ProcessInfo* get_process_subtree(pid_t root, int *count) {
+    *count = 0;
+    
+    const ProcessSnapshot *snapshot = acquire_process_snapshot();
+    if (!snapshot) {
+        return NULL;
+    }
+    
+    int n = snapshot->count;
+    int root_index = -1;
+    for (int i = 0; i < n; i++) {
+        if (snapshot->processes[i].pid == root) {
+            root_index = i;
+            break;
+        }
+    }
+    
+    ProcessInfo *out = NULL;
+    ParentIndexEntry *by_parent = NULL;
+    if (root_index >= 0) {
+        out = malloc((size_t)n * sizeof(ProcessInfo));
+        by_parent = malloc((size_t)n * sizeof(ParentIndexEntry));
+    }
+    
+    if (out && by_parent) {
+        // Índices ordenados por ppid: los hijos de un PID forman un rango contiguo
+        for (int i = 0; i < n; i++) {
+            by_parent[i].ppid = snapshot->processes[i].ppid;
+            by_parent[i].index = i;
+        }
+        qsort(by_parent, (size_t)n, sizeof(ParentIndexEntry), compare_parent_index);
+        
+        int found = 0;
+        out[found++] = snapshot->processes[root_index];
+        for (int k = 0; k < found; k++) {
+            pid_t parent = out[k].pid;
+            
+            // Primera entrada con ppid >= parent (búsqueda binaria)
+            int lo = 0, hi = n;
+            while (lo < hi) {
+                int mid = lo + (hi - lo) / 2;
+                if (by_parent[mid].ppid < parent) lo = mid + 1;
+                else hi = mid;
+            }
+            for (int j = lo; j < n && by_parent[j].ppid == parent && found < n; j++) {
+                if (by_parent[j].index != root_index) {
+                    out[found++] = snapshot->processes[by_parent[j].index];
+                }
+            }
+        }
+        *count = found;
+    } else {
+        free(out);
+        out = NULL;
+    }
+    
+    free(by_parent);
+    release_process_snapshot(snapshot);
+    return out;
+}
+
 /**
  * @brief Limpia todos los recursos del sistema de monitoreo de procesos
  * 
@@ -614,9 +1864,8 @@ ProcessInfo* get_process_list_copy(int *count) {
  * ORDEN DE LIMPIEZA IMPLEMENTADO:
  * 1. Detener hilos de monitoreo (con timeout de seguridad)
  * 2. Limpiar listas de procesos bajo protección de mutex
- * 3. Liberar memoria dinámica (whitelist)
- * 4. Limpiar archivos temporales del sistema
- * 5. Destruir primitivas de sincronización al final
+ * 3. Liberar memoria dinámica (whitelist y tabla de muestras de CPU)
+ * 4. Destruir primitivas de sincronización al final
  * 
  * Este enfoque asegura que el programa pueda cerrarse limpiamente sin dejar
  * recursos colgando en el sistema operativo.
@@ -626,9 +1875,27 @@ void cleanup_monitoring(void) {
     
     // PASO 1: Detener hilos de forma segura usando la función mejorada con timeout
     stop_monitoring();
+    sampler_pool_stop();
     
     pthread_mutex_lock(&mutex);
     clear_process_list();
+    clear_process_snapshots();
+    cpu_sample_table_clear();
+    
+    // Liberar el estado de enumeración de /proc
+    if (proc_dir_fd >= 0) {
+        close(proc_dir_fd);
+        proc_dir_fd = -1;
+    }
+    free(cycle_pids);
+    cycle_pids = NULL;
+    cycle_pids_count = 0;
+    cycle_pids_capacity = 0;
+    free(cycle_samples);
+    cycle_samples = NULL;
+    cycle_samples_capacity = 0;
+    
+    clear_cgroup_state();
     
     // PASO 2: Liberar memoria dinámica de la whitelist de forma segura
     if (config.white_list) {
@@ -642,8 +1909,20 @@ void cleanup_monitoring(void) {
         config.white_list = NULL;
         config.num_white_processes = 0;
     }
+    whitelist_cleanup();
+    for (int i = 0; i < config.num_cgroups; i++) {
+        free(config.cgroup_paths[i]);
+    }
+    free(config.cgroup_paths);
+    config.cgroup_paths = NULL;
+    config.num_cgroups = 0;
     
     event_callbacks = NULL;
+    clear_process_delta();
+    memset(&alert_limiter, 0, sizeof(alert_limiter));
+    memset(&pressure_state, 0, sizeof(pressure_state));
+    pressure_state.available = -1;
+    exe_integrity_stop();
     
     // PASO 3: Asegurar estado consistente antes de destruir recursos de sincronización
     monitoring_active = 0;
@@ -651,17 +1930,569 @@ void cleanup_monitoring(void) {
     
     pthread_mutex_unlock(&mutex);
     
-    // PASO 4: Limpiar archivos temporales para evitar acumulación en el sistema
-    cleanup_stale_temp_files();
-    cleanup_temp_files();
-    
-    // PASO 5: Destruir mutex al final cuando ya no se necesita sincronización
+    // PASO 4: Destruir mutex al final cuando ya no se necesita sincronización
     pthread_mutex_destroy(&mutex);
+    if (monitor_wakeup_ready) {
+        pthread_cond_destroy(&monitor_wakeup);
+        monitor_wakeup_ready = 0;
+    }
     printf("[INFO] ✅ Recursos de monitoreo liberados correctamente\n");
 }
 
+// ===== PUBLICACIÓN DE SNAPSHOTS =====
+
+/**
+ * Construye en privado el snapshot del ciclo a partir del slab de procesos.
+ * Reutiliza el snapshot retirado en el ciclo anterior si ningún lector lo
+ * retiene (doble buffer); si no, lo suelta y reserva uno nuevo.
+ * 
+ * @return ProcessSnapshot*: Snapshot con una referencia del monitor, o NULL si no hay memoria
+ */
+static ProcessSnapshot* build_process_snapshot(void) {
+    ProcessSnapshot *snapshot = NULL;
+    
+    if (retired_snapshot) {
+        // Ya no está publicado: su contador solo puede bajar
+        if (__sync_add_and_fetch(&retired_snapshot->refcount, 0) == 1) {
+            snapshot = retired_snapshot;
+        } else {
+            release_process_snapshot(retired_snapshot);
+        }
+        retired_snapshot = NULL;
+    }
+    
+    if (!snapshot) {
+        snapshot = calloc(1, sizeof(ProcessSnapshot));
+        if (!snapshot) {
+            fprintf(stderr, "[ERROR] No se pudo asignar memoria para el snapshot de procesos\n");
+            return NULL;
+        }
+        snapshot->refcount = 1;
+    }
+    
+    if (snapshot->capacity < num_procesos_activos) {
+        int new_capacity = snapshot->capacity ? snapshot->capacity : PROCESS_SLAB_INITIAL_CAPACITY;
+        while (new_capacity < num_procesos_activos) new_capacity *= 2;
+        
+        ProcessInfo *temp = realloc(snapshot->processes, (size_t)new_capacity * sizeof(ProcessInfo));
+        if (!temp) {
+            fprintf(stderr, "[ERROR] No se pudo expandir el snapshot de procesos\n");
+            release_process_snapshot(snapshot);
+            return NULL;
+        }
+        snapshot->processes = temp;
+        snapshot->capacity = new_capacity;
+    }
+    
+    snapshot->count = 0;
+    count_threshold_columns(snapshot);
+    
+    // Rankings acotados que se llenan en la misma pasada que la copia. Se
+    // rehacen en cada publicación a propósito: la copia ya recorre todas las
+    // ranuras, así que el heap solo añade O(log K) por proceso, y los índices
+    // que guarda top[] apuntan a posiciones de este snapshot, que cambian al
+    // compactar el slab. Mantenerlos entre ciclos exigiría además sacar del
+    // heap a los procesos cuyo consumo baja o que terminan, algo que un heap
+    // mínimo de K entradas no sabe hacer sin un índice por PID.
+    TopHeapEntry heaps[TOP_METRIC_COUNT][PROCESS_TOP_K];
+    int heap_sizes[TOP_METRIC_COUNT] = {0};
+    
+    for (int i = 0; i < procesos_high_water; i++) {
+        if (!(proc_columns.flags[i] & SLOT_IN_USE)) continue;
+        int index = snapshot->count++;
+        slot_to_info(i, &snapshot->processes[index]);
+        
+        top_heap_offer(heaps[TOP_BY_CPU], &heap_sizes[TOP_BY_CPU], proc_columns.cpu_usage[i], index);
+        top_heap_offer(heaps[TOP_BY_RSS], &heap_sizes[TOP_BY_RSS], (float)procesos_activos[i].rss_kb, index);
+        top_heap_offer(heaps[TOP_BY_IO], &heap_sizes[TOP_BY_IO], proc_columns.io_kbps[i], index);
+    }
+    
+    for (int m = 0; m < TOP_METRIC_COUNT; m++) {
+        snapshot->top_count[m] = top_heap_drain(heaps[m], heap_sizes[m], snapshot->top[m]);
+    }
+    
+    snapshot->cgroup_count = 0;
+    if (num_cgroup_infos > snapshot->cgroup_capacity) {
+        ProcessInfo *temp = realloc(snapshot->cgroups, (size_t)num_cgroup_infos * sizeof(ProcessInfo));
+        if (temp) {
+            snapshot->cgroups = temp;
+            snapshot->cgroup_capacity = num_cgroup_infos;
+        }
+    }
+    if (num_cgroup_infos <= snapshot->cgroup_capacity) {
+        memcpy(snapshot->cgroups, cgroup_infos, (size_t)num_cgroup_infos * sizeof(ProcessInfo));
+        snapshot->cgroup_count = num_cgroup_infos;
+    }
+    
+    snapshot->pressure_available = pressure_state.available == 1;
+    snapshot->pressure = pressure_state.last;
+    snapshot->stalled = snapshot->pressure_available ? pressure_state.stalled : 0;
+    
+    snapshot->cycle = ++snapshot_cycle;
+    snapshot->timestamp = time(NULL);
+    return snapshot;
+}
+
+/**
+ * Ofrece un proceso a un heap mínimo de PROCESS_TOP_K entradas. La raíz es
+ * el menor de los retenidos, así que cada oferta cuesta O(log K) y los
+ * procesos sin consumo no entran.
+ */
+static void top_heap_offer(TopHeapEntry *heap, int *size, float key, int index) {
+    if (key <= 0.0f) return;
+    
+    int pos;
+    if (*size < PROCESS_TOP_K) {
+        // Insertar al final y subir
+        pos = (*size)++;
+        while (pos > 0 && heap[(pos - 1) / 2].key > key) {
+            heap[pos] = heap[(pos - 1) / 2];
+            pos = (pos - 1) / 2;
+        }
+    } else {
+        if (key <= heap[0].key) return;
+        // Reemplazar la raíz y bajar
+        pos = 0;
+        for (;;) {
+            int child = 2 * pos + 1;
+            if (child >= PROCESS_TOP_K) break;
+            if (child + 1 < PROCESS_TOP_K && heap[child + 1].key < heap[child].key) child++;
+            if (heap[child].key >= key) break;
+            heap[pos] = heap[child];
+            pos = child;
+        }
+    }
+    heap[pos].key = key;
+    heap[pos].index = index;
+}
+
+/**
+ * Vacía el heap escribiendo los índices de mayor a menor clave
+ * 
+ * @return int: Número de índices escritos
+ */
+static int top_heap_drain(TopHeapEntry *heap, int size, int *out) {
+    int count = size;
+    
+    // Extraer repetidamente el mínimo y colocarlo al final de la salida
+    while (size > 0) {
+        out[size - 1] = heap[0].index;
+        TopHeapEntry last = heap[--size];
+        int pos = 0;
+        for (;;) {
+            int child = 2 * pos + 1;
+            if (child >= size) break;
+            if (child + 1 < size && heap[child + 1].key < heap[child].key) child++;
+            if (heap[child].key >= last.key) break;
+            heap[pos] = heap[child];
+            pos = child;
+        }
+        if (size > 0) heap[pos] = last;
+    }
+    
+    return count;
+}
+
+/**
+ * Publica un snapshot con un único intercambio de puntero. El anterior queda
+ * retirado con la referencia del monitor, y se libera o reutiliza después.
+ */
+static void publish_process_snapshot(ProcessSnapshot *snapshot) {
+    pthread_mutex_lock(&snapshot_lock);
+    ProcessSnapshot *previous = published_snapshot;
+    published_snapshot = snapshot;
+    pthread_mutex_unlock(&snapshot_lock);
+    
+    retired_snapshot = previous;
+}
+
+static void clear_process_snapshots(void) {
+    pthread_mutex_lock(&snapshot_lock);
+    ProcessSnapshot *previous = published_snapshot;
+    published_snapshot = NULL;
+    pthread_mutex_unlock(&snapshot_lock);
+    
+    release_process_snapshot(previous);
+    release_process_snapshot(retired_snapshot);
+    retired_snapshot = NULL;
+}
+
+// ===== DIFF POR CICLO =====
+
+/**
+ * Agrega una copia del proceso a la lista de cambios pendientes. Sin
+ * callbacks registrados no se guarda nada.
+ */
+static void delta_record(DeltaListKind kind, const ProcessInfo *info, unsigned int alert_kinds) {
+    if (!event_callbacks || !info) return;
+    
+    DeltaList *list = &delta_lists[kind];
+    
+    // fork() seguido de exec() llega como dos altas del mismo PID casi
+    // seguidas: la segunda reemplaza a la primera dentro de la entrega
+    if (kind == DELTA_ADDED || kind == DELTA_CHANGED) {
+        int oldest = list->count > DELTA_COALESCE_WINDOW ? list->count - DELTA_COALESCE_WINDOW : 0;
+        for (int i = list->count - 1; i >= oldest; i--) {
+            if (list->entries[i].info.pid == info->pid) {
+                list->entries[i].info = *info;
+                list->entries[i].alert_kinds |= alert_kinds;
+                return;
+            }
+        }
+    }
+    
+    if (list->count >= list->capacity) {
+        int new_capacity = list->capacity ? list->capacity * 2 : DELTA_INITIAL_CAPACITY;
+        ProcessDeltaEntry *temp = realloc(list->entries, (size_t)new_capacity * sizeof(ProcessDeltaEntry));
+        if (!temp) {
+            fprintf(stderr, "[ERROR] No se pudo expandir el diff del ciclo\n");
+            return;
+        }
+        list->entries = temp;
+        list->capacity = new_capacity;
+    }
+    
+    list->entries[list->count].info = *info;
+    list->entries[list->count].alert_kinds = alert_kinds;
+    list->count++;
+}
+
+/**
+ * Igual que delta_record() para un proceso del slab. La ProcessInfo se arma
+ * desde las columnas y el registro de la ranura solo si hay callbacks.
+ */
+static void delta_record_slot(DeltaListKind kind, int idx, unsigned int alert_kinds) {
+    if (!event_callbacks) return;
+    
+    ProcessInfo info;
+    slot_to_info(idx, &info);
+    delta_record(kind, &info, alert_kinds);
+}
+
+static int delta_pending(void) {
+    for (int k = 0; k < DELTA_LIST_COUNT; k++) {
+        if (delta_lists[k].count > 0) return 1;
+    }
+    return (pressure_state.raised | pressure_state.cleared) != 0 || pending_log.length > 0;
+}
+
+static int delta_entry_count(void) {
+    int total = 0;
+    for (int k = 0; k < DELTA_LIST_COUNT; k++) {
+        total += delta_lists[k].count;
+    }
+    return total;
+}
+
+/**
+ * Adaptador para los callbacks por evento: los llama a partir del diff, así
+ * que cada transición se notifica una sola vez por entrega
+ */
+static void dispatch_event_callbacks(const ProcessCallbacks *cb, DeltaBatch *batch) {
+    DeltaList *list = &batch->lists[DELTA_ADDED];
+    for (int i = 0; i < list->count && cb->on_new_process; i++) {
+        cb->on_new_process(&list->entries[i].info);
+    }
+    
+    list = &batch->lists[DELTA_REMOVED];
+    for (int i = 0; i < list->count && cb->on_process_terminated; i++) {
+        cb->on_process_terminated(list->entries[i].info.pid, list->entries[i].info.name);
+    }
+    
+    list = &batch->lists[DELTA_ALERT_RAISED];
+    for (int i = 0; i < list->count; i++) {
+        ProcessInfo *info = &list->entries[i].info;
+        unsigned int kinds = list->entries[i].alert_kinds;
+        if ((kinds & ALERT_KIND_CPU) && cb->on_high_cpu_alert) cb->on_high_cpu_alert(info);
+        if ((kinds & ALERT_KIND_MEMORY) && cb->on_high_memory_alert) cb->on_high_memory_alert(info);
+        if ((kinds & ALERT_KIND_IO) && cb->on_high_io_alert) cb->on_high_io_alert(info);
+        if ((kinds & ALERT_KIND_SUBTREE) && cb->on_subtree_alert) cb->on_subtree_alert(info);
+        if ((kinds & ALERT_KIND_MEMORY_GROWTH) && cb->on_memory_growth_alert) cb->on_memory_growth_alert(info);
+        if ((kinds & ALERT_KIND_EXECUTABLE) && cb->on_executable_alert) cb->on_executable_alert(info);
+    }
+    
+    // on_alert_cleared solo cubre las alertas por umbral del propio proceso
+    list = &batch->lists[DELTA_ALERT_CLEARED];
+    for (int i = 0; i < list->count && cb->on_alert_cleared; i++) {
+        unsigned int kinds = list->entries[i].alert_kinds;
+        if (kinds == 0 || (kinds & (ALERT_KIND_CPU | ALERT_KIND_MEMORY | ALERT_KIND_IO))) {
+            cb->on_alert_cleared(&list->entries[i].info);
+        }
+    }
+    
+    // Alertas de presión: del sistema, no de un proceso
+    for (int r = 0; r < PSI_RESOURCE_COUNT; r++) {
+        unsigned int bit = 1u << r;
+        if ((batch->stalls_raised & bit) && cb->on_pressure_alert) {
+            cb->on_pressure_alert(&batch->pressure, (PsiResource)r);
+        }
+        if ((batch->stalls_cleared & bit) && cb->on_pressure_cleared) {
+            cb->on_pressure_cleared(&batch->pressure, (PsiResource)r);
+        }
+    }
+}
+
+/**
+ * Extrae los cambios acumulados y los mensajes del ciclo intercambiando sus
+ * listas con las del lote, que deben estar vacías. El resumen de alertas
+ * suprimidas y las alertas de presión viajan en el mismo diff.
+ * Debe llamarse con el mutex global tomado.
+ * 
+ * @return int: 1 si hay algo que entregar, 0 si no
+ */
+static int take_process_delta(DeltaBatch *batch) {
+    int suppressed = alert_take_suppressed_summary();
+    if (!delta_pending() && suppressed == 0) return 0;
+    
+    for (int k = 0; k < DELTA_LIST_COUNT; k++) {
+        DeltaList taken = delta_lists[k];
+        delta_lists[k] = batch->lists[k];
+        delta_lists[k].count = 0;
+        batch->lists[k] = taken;
+    }
+    LogBuffer log = pending_log;
+    pending_log = batch->log;
+    pending_log.length = 0;
+    batch->log = log;
+    
+    // Copia por valor: la entrega corre sin el mutex y set_process_callbacks()
+    // puede cambiar o liberar la estructura registrada mientras tanto
+    batch->has_callbacks = event_callbacks != NULL;
+    if (batch->has_callbacks) {
+        batch->callbacks = *event_callbacks;
+    }
+    batch->cycle = batch->has_callbacks ? ++delta_cycle : delta_cycle;
+    batch->num_alerts_suppressed = suppressed;
+    batch->has_pressure = pressure_state.available == 1;
+    batch->pressure = pressure_state.last;
+    batch->stalls_raised = pressure_state.raised;
+    batch->stalls_cleared = pressure_state.cleared;
+    pressure_state.raised = 0;
+    pressure_state.cleared = 0;
+    return 1;
+}
+
+/**
+ * Escribe los mensajes del lote y lo entrega: primero el diff completo a
+ * on_cycle_delta y después, desde el mismo diff, los callbacks por evento.
+ * Se llama sin el mutex global, así que los callbacks pueden consultar el
+ * monitor; al terminar el lote queda vacío para la próxima extracción.
+ */
+static void deliver_process_delta(DeltaBatch *batch) {
+    if (batch->log.length > 0) {
+        fwrite(batch->log.text, 1, batch->log.length, stdout);
+        batch->log.length = 0;
+    }
+    
+    if (batch->has_callbacks) {
+        const ProcessCallbacks *cb = &batch->callbacks;
+        ProcessDelta delta;
+        delta.cycle = batch->cycle;
+        delta.added = batch->lists[DELTA_ADDED].entries;
+        delta.num_added = batch->lists[DELTA_ADDED].count;
+        delta.removed = batch->lists[DELTA_REMOVED].entries;
+        delta.num_removed = batch->lists[DELTA_REMOVED].count;
+        delta.changed = batch->lists[DELTA_CHANGED].entries;
+        delta.num_changed = batch->lists[DELTA_CHANGED].count;
+        delta.alerts_raised = batch->lists[DELTA_ALERT_RAISED].entries;
+        delta.num_alerts_raised = batch->lists[DELTA_ALERT_RAISED].count;
+        delta.alerts_cleared = batch->lists[DELTA_ALERT_CLEARED].entries;
+        delta.num_alerts_cleared = batch->lists[DELTA_ALERT_CLEARED].count;
+        delta.num_alerts_suppressed = batch->num_alerts_suppressed;
+        delta.pressure = batch->has_pressure ? &batch->pressure : NULL;
+        delta.stalls_raised = batch->stalls_raised;
+        delta.stalls_cleared = batch->stalls_cleared;
+        
+        if (cb->on_cycle_delta) {
+            cb->on_cycle_delta(&delta);
+        }
+        dispatch_event_callbacks(cb, batch);
+    }
+    
+    for (int k = 0; k < DELTA_LIST_COUNT; k++) {
+        batch->lists[k].count = 0;
+    }
+    batch->has_callbacks = 0;
+}
+
+/**
+ * Extrae el diff pendiente y lo entrega con el mutex global suelto. Se llama
+ * y retorna con el mutex tomado; durante la entrega otros hilos pueden
+ * registrar cambios nuevos en las listas pendientes.
+ */
+static void hand_off_process_delta(DeltaBatch *batch) {
+    if (!take_process_delta(batch)) return;
+    pthread_mutex_unlock(&mutex);
+    deliver_process_delta(batch);
+    pthread_mutex_lock(&mutex);
+}
+
+static void free_delta_batch(DeltaBatch *batch) {
+    for (int k = 0; k < DELTA_LIST_COUNT; k++) {
+        free(batch->lists[k].entries);
+    }
+    free(batch->log.text);
+    memset(batch, 0, sizeof(DeltaBatch));
+}
+
+/**
+ * printf() diferido: agrega el mensaje a pending_log para escribirlo al
+ * entregar el diff, fuera del mutex global. Si no hay memoria lo escribe
+ * directamente. Debe llamarse con el mutex global tomado.
+ */
+static void monitor_log(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list retry;
+    va_copy(retry, args);
+    int needed = vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+    
+    if (needed >= 0) {
+        size_t required = pending_log.length + (size_t)needed + 1;
+        if (required > pending_log.capacity) {
+            size_t new_capacity = pending_log.capacity ? pending_log.capacity : LOG_BUFFER_INITIAL_CAPACITY;
+            while (new_capacity < required) new_capacity *= 2;
+            char *temp = realloc(pending_log.text, new_capacity);
+            if (!temp) {
+                vprintf(fmt, retry);
+                va_end(retry);
+                return;
+            }
+            pending_log.text = temp;
+            pending_log.capacity = new_capacity;
+        }
+        vsnprintf(pending_log.text + pending_log.length, pending_log.capacity - pending_log.length, fmt, retry);
+        pending_log.length += (size_t)needed;
+    }
+    va_end(retry);
+}
+
+static void clear_process_delta(void) {
+    for (int k = 0; k < DELTA_LIST_COUNT; k++) {
+        free(delta_lists[k].entries);
+        delta_lists[k].entries = NULL;
+        delta_lists[k].count = 0;
+        delta_lists[k].capacity = 0;
+    }
+    free(pending_log.text);
+    memset(&pending_log, 0, sizeof(LogBuffer));
+}
+
 // ===== FUNCIONES DE ALERTAS =====
 
+/**
+ * Tipos de umbral que el proceso supera escalados por una fracción: 1.0 es la
+ * banda de entrada de la alerta y alert_hysteresis la de salida
+ */
+static unsigned int threshold_kinds_above(const ProcessInfo *info, float fraction) {
+    unsigned int kinds = 0;
+    if (info->cpu_usage > config.max_cpu_usage * fraction) kinds |= ALERT_KIND_CPU;
+    if (info->mem_usage > config.max_ram_usage * fraction) kinds |= ALERT_KIND_MEMORY;
+    if (config.max_io_kbps > 0 && info->io_kbps > config.max_io_kbps * fraction) kinds |= ALERT_KIND_IO;
+    return kinds;
+}
+
+/**
+ * Toma una ficha del límite global. Las fichas se recargan a
+ * alerts_per_minute por minuto hasta un máximo de alert_burst.
+ * @return int: 1 si se puede notificar, 0 si el cubo está vacío
+ */
+static int alert_limiter_take(void) {
+    if (config.alerts_per_minute <= 0) return 1;
+    
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double burst = config.alert_burst > 0 ? config.alert_burst : 1;
+    
+    if (!alert_limiter.initialized) {
+        alert_limiter.tokens = burst;
+        alert_limiter.initialized = 1;
+    } else {
+        double elapsed = (now.tv_sec - alert_limiter.last_refill.tv_sec) +
+                         (now.tv_nsec - alert_limiter.last_refill.tv_nsec) / 1e9;
+        alert_limiter.tokens += elapsed * config.alerts_per_minute / 60.0;
+        if (alert_limiter.tokens > burst) alert_limiter.tokens = burst;
+    }
+    alert_limiter.last_refill = now;
+    
+    if (alert_limiter.tokens < 1.0) return 0;
+    alert_limiter.tokens -= 1.0;
+    return 1;
+}
+
+/**
+ * Decide si se notifica ya la activación de una alerta. Una activación
+ * retenida no se pierde: se vuelve a intentar en cada evaluación mientras
+ * la alerta siga activa, y cuenta una sola vez en el resumen.
+ * - Enfriamiento: un proceso notificado hace menos de alert_cooldown
+ *   segundos no vuelve a notificarse (deduplica alertas intermitentes)
+ * - Límite global: cubo de fichas compartido por todos los procesos
+ * 
+ * @param kinds: Clase de alerta (umbrales, subárbol o fuga)
+ * @return int: 1 si la activación debe notificarse
+ */
+static int alert_may_notify(ProcessState *state, unsigned int kinds, time_t now) {
+    if (state->notified_kinds & kinds) return 0;
+    
+    int cooling = config.alert_cooldown > 0 && state->last_alert_emitted != 0 &&
+                  now - state->last_alert_emitted < config.alert_cooldown;
+    if (cooling || !alert_limiter_take()) {
+        if (!(state->suppressed_kinds & kinds)) {
+            state->suppressed_kinds |= kinds;
+            if (cooling) alert_limiter.deduplicated++;
+            else alert_limiter.rate_limited++;
+        }
+        return 0;
+    }
+    
+    state->notified_kinds |= kinds;
+    state->suppressed_kinds &= ~kinds;
+    state->last_alert_emitted = now;
+    return 1;
+}
+
+/**
+ * Olvida la notificación de una alerta que se despeja
+ * @return int: 1 si su activación se había notificado (el despeje también se notifica)
+ */
+static int alert_forget_notification(ProcessState *state, unsigned int kinds) {
+    int notified = (state->notified_kinds & kinds) != 0;
+    state->notified_kinds &= ~kinds;
+    state->suppressed_kinds &= ~kinds;
+    return notified;
+}
+
+/**
+ * Resume las activaciones retenidas, como mucho una vez cada
+ * ALERT_SUMMARY_INTERVAL segundos
+ * @return int: Activaciones resumidas (0 si no hay resumen en esta llamada)
+ */
+static int alert_take_suppressed_summary(void) {
+    int total = alert_limiter.rate_limited + alert_limiter.deduplicated;
+    if (total == 0) return 0;
+    
+    time_t now = time(NULL);
+    if (alert_limiter.last_summary != 0 && now - alert_limiter.last_summary < ALERT_SUMMARY_INTERVAL) {
+        return 0;
+    }
+    
+    monitor_log("[ALERTAS SUPRIMIDAS] %d retenidas por el límite global y %d por enfriamiento\n",
+                alert_limiter.rate_limited, alert_limiter.deduplicated);
+    alert_limiter.rate_limited = 0;
+    alert_limiter.deduplicated = 0;
+    alert_limiter.last_summary = now;
+    return total;
+}
+
+/**
+ * Máquina de estados de las alertas por umbral de un proceso:
+ * - NORMAL -> PENDIENTE al superar algún umbral (banda de entrada)
+ * - PENDIENTE -> ACTIVA tras alert_duration segundos sin bajar de la banda de salida
+ * - PENDIENTE o ACTIVA -> NORMAL al quedar todo por debajo de la banda de
+ *   salida (alert_hysteresis × umbral), así un valor que oscila alrededor
+ *   del umbral no abre y cierra la alerta en cada ciclo
+ */
 static void check_and_update_alert_status(ProcessInfo *info) {
     if (!info) return;
     
@@ -675,87 +2506,691 @@ static void check_and_update_alert_status(ProcessInfo *info) {
     
     // Verificar si excede umbrales según la fórmula del RF2:
     // alerta = (uso_CPU > UMBRAL_CPU) ∨ (uso_RAM > UMBRAL_RAM)
-    int exceeds_now = (info->cpu_usage > config.max_cpu_usage) || 
-                      (info->mem_usage > config.max_ram_usage);
-    
-    if (exceeds_now) {
-        if (!info->exceeds_thresholds) {
-            // Primera vez que excede umbrales
-            info->exceeds_thresholds = 1;
-            info->first_threshold_exceed = current_time;
-            printf("[INFO] Proceso %s (PID: %d) comenzó a exceder umbrales. CPU: %.2f%%, MEM: %.2f%%\n",
-                   info->name, info->pid, info->cpu_usage, info->mem_usage);
-        } else {
-            // Ya estaba excediendo, verificar duración
-            int duration = (int)(current_time - info->first_threshold_exceed);
-            
-            if (duration >= config.alert_duration && !info->alerta_activa) {
-                // Activar alerta después de la duración configurada
-                info->alerta_activa = 1;
-                info->inicio_alerta = current_time;
-                
-                printf("[ALERTA ACTIVADA] PID: %d, Nombre: %s, Duración: %d seg, CPU: %.2f%%, MEM: %.2f%%\n",
-                       info->pid, info->name, duration, info->cpu_usage, info->mem_usage);
-                
-                // Callbacks específicos según el tipo de exceso
-                if (info->cpu_usage > config.max_cpu_usage && event_callbacks && event_callbacks->on_high_cpu_alert) {
-                    event_callbacks->on_high_cpu_alert(info);
-                }
-                if (info->mem_usage > config.max_ram_usage && event_callbacks && event_callbacks->on_high_memory_alert) {
-                    event_callbacks->on_high_memory_alert(info);
-                }
-            }
-        }
-    } else {
-        // Ya no excede umbrales
+    if (!info->state.exceeds_thresholds) {
+        if (threshold_kinds_above(info, 1.0f) == 0) return;
+        
+        // Primera vez que excede umbrales
+        info->state.exceeds_thresholds = 1;
+        info->state.first_threshold_exceed = current_time;
+        monitor_log("[INFO] Proceso %s (PID: %d) comenzó a exceder umbrales. CPU: %.2f%%, MEM: %.2f%%\n",
+                    info->name, info->pid, info->cpu_usage, info->mem_usage);
+        return;
+    }
+    
+    unsigned int kinds = threshold_kinds_above(info, config.alert_hysteresis);
+    if (kinds == 0) {
+        // Bajó de la banda de salida
         clear_alert_if_needed(info);
+        return;
+    }
+    
+    // Ya estaba excediendo, verificar duración
+    int duration = (int)(current_time - info->state.first_threshold_exceed);
+    if (!info->state.alerta_activa) {
+        if (duration < config.alert_duration) return;
+        
+        // Activar alerta después de la duración configurada
+        info->state.alerta_activa = 1;
+        info->state.inicio_alerta = current_time;
+    }
+    // Tipos de exceso de la alerta, para el diff del ciclo
+    info->state.alert_kinds |= kinds;
+    
+    if (alert_may_notify(&info->state, ALERT_THRESHOLD_KINDS, current_time)) {
+        monitor_log("[ALERTA ACTIVADA] PID: %d, Nombre: %s, Duración: %d seg, CPU: %.2f%%, MEM: %.2f%%\n",
+                    info->pid, info->name, duration, info->cpu_usage, info->mem_usage);
+        for (int t = 0; t < info->num_hot_threads; t++) {
+            monitor_log("    Hilo TID: %d, Nombre: %s, CPU: %.2f%%\n", info->hot_threads[t].tid,
+                        info->hot_threads[t].name, info->hot_threads[t].cpu_usage);
+        }
+        delta_record(DELTA_ALERT_RAISED, info, info->state.alert_kinds);
     }
 }
 
 static void clear_alert_if_needed(ProcessInfo *info) {
     if (!info) return;
     
-    if (info->exceeds_thresholds || info->alerta_activa) {
-        int was_active = info->alerta_activa;
+    if (info->state.exceeds_thresholds || info->state.alerta_activa) {
+        int was_active = info->state.alerta_activa;
         
         // Resetear todos los campos de alerta
-        info->exceeds_thresholds = 0;
-        info->first_threshold_exceed = 0;
-        info->alerta_activa = 0;
-        info->inicio_alerta = 0;
+        info->state.exceeds_thresholds = 0;
+        info->state.first_threshold_exceed = 0;
+        info->state.alerta_activa = 0;
+        info->state.inicio_alerta = 0;
+        
+        // Solo se despeja en voz alta lo que se notificó al activarse
+        if (was_active && alert_forget_notification(&info->state, ALERT_THRESHOLD_KINDS)) {
+            monitor_log("[ALERTA DESPEJADA] PID: %d, Nombre: %s volvió a valores normales. CPU: %.2f%%, MEM: %.2f%%\n",
+                        info->pid, info->name, info->cpu_usage, info->mem_usage);
+            delta_record(DELTA_ALERT_CLEARED, info, info->state.alert_kinds);
+        }
+        info->state.alert_kinds = 0;
+    }
+}
+
+/**
+ * Agrega la muestra al ajuste lineal del RSS del proceso y alerta cuando
+ * crece de forma sostenida: pendiente y R² por encima de los mínimos
+ * configurados durante al menos media ventana. Detecta una fuga mientras
+ * el proceso todavía está lejos de UMBRAL_RAM.
+ */
+static void update_memory_trend(int idx, const struct timespec *taken, const CycleContext *ctx) {
+    if (config.growth_window <= 0) return;
+    
+    ActiveProcess *ap = &procesos_activos[idx];
+    ProcessState *state = &ap->state;
+    pid_t pid = proc_columns.pid[idx];
+    
+    memory_trend_add(&ap->memory_trend, taken, ap->rss_kb, (double)config.growth_window);
+    
+    double slope = 0.0, r2 = 0.0;
+    int fitted = memory_trend_fit(&ap->memory_trend, &slope, &r2) == 0;
+    state->mem_growth_kbps = fitted ? (float)slope : 0.0f;
+    state->mem_growth_r2 = fitted ? (float)r2 : 0.0f;
+    
+    // Para despejarse, pendiente y R² deben bajar de la banda de salida
+    float band = state->mem_growth_alert ? config.alert_hysteresis : 1.0f;
+    int growing = fitted && !ap->is_whitelisted &&
+                  memory_trend_span(&ap->memory_trend) >= config.growth_window / 2.0 &&
+                  slope >= config.growth_min_kbps * band && r2 >= config.growth_min_r2 * band;
+    
+    if (growing && !state->mem_growth_alert) {
+        state->mem_growth_alert = 1;
+    } else if (!growing && state->mem_growth_alert) {
+        state->mem_growth_alert = 0;
+        if (alert_forget_notification(state, ALERT_KIND_MEMORY_GROWTH)) {
+            monitor_log("[FUGA DESPEJADA] PID: %d, Nombre: %s, RSS: %lu kB, Pendiente: %.1f kB/s (R²: %.2f)\n",
+                        pid, ap->name, ap->rss_kb, slope, r2);
+            delta_record_slot(DELTA_ALERT_CLEARED, idx, ALERT_KIND_MEMORY_GROWTH);
+        }
+    }
+    
+    if (state->mem_growth_alert && alert_may_notify(state, ALERT_KIND_MEMORY_GROWTH, time(NULL))) {
+        // Tiempo estimado hasta UMBRAL_RAM si el ritmo se mantiene
+        double pct_per_second = ctx->mem_total_kb > 0 ? slope * 100.0 / ctx->mem_total_kb : 0.0;
+        double remaining = config.max_ram_usage - proc_columns.mem_usage[idx];
+        if (pct_per_second > 0.0 && remaining > 0.0) {
+            monitor_log("[ALERTA FUGA] PID: %d, Nombre: %s, RSS: %lu kB, Crece: %.1f kB/s (R²: %.2f), "
+                        "UMBRAL_RAM en ~%.0f seg\n", pid, ap->name, ap->rss_kb,
+                        slope, r2, remaining / pct_per_second);
+        } else {
+            monitor_log("[ALERTA FUGA] PID: %d, Nombre: %s, RSS: %lu kB, Crece: %.1f kB/s (R²: %.2f)\n",
+                        pid, ap->name, ap->rss_kb, slope, r2);
+        }
+        delta_record_slot(DELTA_ALERT_RAISED, idx, ALERT_KIND_MEMORY_GROWTH);
+    }
+}
+
+/**
+ * Revisa el ejecutable de un proceso: alerta si se borró del disco o vive
+ * solo en memoria (memfd) y recoge su SHA-256 cuando el hilo de hashing lo
+ * tiene listo. No bloquea: mientras el hash está pendiente se vuelve a
+ * consultar la caché en el próximo ciclo completo.
+ */
+static void check_process_executable(int idx) {
+    ActiveProcess *ap = &procesos_activos[idx];
+    ProcessState *state = &ap->state;
+    
+    ExeIntegrity result;
+    if (ap->is_whitelisted || exe_integrity_check(proc_columns.pid[idx], &result) != 0) {
+        ap->exe_checked = 1; // En whitelist, hilo del kernel o sin permiso para inspeccionarlo
+        return;
+    }
+    
+    state->exe_flags = result.flags;
+    if (result.state == EXE_HASH_DONE) {
+        memcpy(state->exe_sha256, result.sha256, sizeof(state->exe_sha256));
+    }
+    
+    if (result.flags == 0) {
+        if (alert_forget_notification(state, ALERT_KIND_EXECUTABLE)) {
+            delta_record_slot(DELTA_ALERT_CLEARED, idx, ALERT_KIND_EXECUTABLE);
+        }
+    } else if (alert_may_notify(state, ALERT_KIND_EXECUTABLE, time(NULL))) {
+        monitor_log("[ALERTA EJECUTABLE] PID: %d, Nombre: %s, Motivo: %s, SHA-256: %s\n",
+                    proc_columns.pid[idx], ap->name,
+                    (result.flags & EXE_FLAG_MEMFD) ? "binario en memoria (memfd)" : "binario borrado del disco",
+                    result.state == EXE_HASH_DONE ? state->exe_sha256 :
+                    result.state == EXE_HASH_PENDING ? "pendiente" : "no calculado");
+        delta_record_slot(DELTA_ALERT_RAISED, idx, ALERT_KIND_EXECUTABLE);
+    }
+    
+    // Se reintenta mientras falte el hash o la notificación de una alerta retenida
+    ap->exe_checked = result.state != EXE_HASH_PENDING &&
+                      (result.flags == 0 || (state->notified_kinds & ALERT_KIND_EXECUTABLE));
+}
+
+// ===== FUNCIONES DE ACCESO A /proc =====
+
+// Entrada devuelta por getdents64 (no expuesta por glibc)
+struct linux_dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+/**
+ * Enumera los PIDs de /proc con getdents64 sobre un descriptor y un buffer
+ * que se reutilizan entre ciclos. Las entradas se filtran mirando solo sus
+ * caracteres, sin strtol: un PID no empieza por '0' y es todo dígitos.
+ * 
+ * @return int: Número de PIDs en cycle_pids, o -1 si hay error
+ */
+static int enumerate_pids(void) {
+    if (proc_dir_fd < 0) {
+        proc_dir_fd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (proc_dir_fd < 0) {
+            perror("Error al abrir /proc");
+            return -1;
+        }
+    } else if (lseek(proc_dir_fd, 0, SEEK_SET) < 0) {
+        perror("Error al rebobinar /proc");
+        return -1;
+    }
+    
+    cycle_pids_count = 0;
+    
+    for (;;) {
+        long nread = syscall(SYS_getdents64, proc_dir_fd, dents_buffer, sizeof(dents_buffer));
+        if (nread < 0) {
+            perror("Error al leer /proc");
+            return -1;
+        }
+        if (nread == 0) break;
+        
+        long offset = 0;
+        while (offset < nread) {
+            struct linux_dirent64 *entry = (struct linux_dirent64 *)((char *)dents_buffer + offset);
+            offset += entry->d_reclen;
+            
+            const char *c = entry->d_name;
+            if (*c < '1' || *c > '9') continue;
+            
+            pid_t pid = 0;
+            while (*c >= '0' && *c <= '9') {
+                pid = pid * 10 + (*c - '0');
+                c++;
+            }
+            if (*c != '\0') continue;
+            
+            if (cycle_pids_count >= cycle_pids_capacity) {
+                int new_capacity = cycle_pids_capacity ? cycle_pids_capacity * 2 : 1024;
+                pid_t *temp = realloc(cycle_pids, (size_t)new_capacity * sizeof(pid_t));
+                if (!temp) {
+                    fprintf(stderr, "[ERROR] No se pudo expandir la lista de PIDs\n");
+                    return cycle_pids_count;
+                }
+                cycle_pids = temp;
+                cycle_pids_capacity = new_capacity;
+            }
+            cycle_pids[cycle_pids_count++] = pid;
+        }
+    }
+    
+    return cycle_pids_count;
+}
+
+// ===== MUESTREO POR HILOS (/proc/[pid]/task) =====
+
+/**
+ * Decide si vale la pena descender a los hilos de un proceso. El coste se
+ * acota leyendo solo procesos por encima de task_cpu_floor o marcados para
+ * investigación con set_process_investigation().
+ * 
+ * @param idx: Ranura del proceso, o -1 si aún no está registrado
+ */
+static int should_sample_tasks(const ProcessInfo *info, int idx) {
+    if (!config.task_monitoring || info->is_whitelisted) return 0;
+    int investigated = idx != -1 && procesos_activos[idx].investigated;
+    // Bajo presión solo se desciende a los hilos de los procesos investigados
+    if (pressure_state.level != LOAD_LEVEL_NORMAL) return investigated;
+    if (info->cpu_usage >= config.task_cpu_floor) return 1;
+    return investigated;
+}
+
+/**
+ * Lee /proc/[pid]/task/[tid]/stat de cada hilo y calcula su CPU% con la misma
+ * tabla de muestras que los procesos (entradas con is_task = 1). Deja en info
+ * los PROCESS_HOT_THREADS hilos con más consumo, de mayor a menor.
+ * 
+ * @return int: Hilos leídos, o -1 si no se pudo abrir el directorio de tareas
+ */
+static int sample_process_tasks(const CycleContext *ctx, ProcessInfo *info) {
+    info->num_hot_threads = 0;
+    
+    int pid_fd = open_pid_dir(info->pid);
+    if (pid_fd < 0) return -1;
+    int task_fd = openat(pid_fd, "task", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    close(pid_fd);
+    if (task_fd < 0) return -1;
+    
+    uint64_t dents[8192 / sizeof(uint64_t)];  // Alineado para linux_dirent64
+    char buf[STAT_BUFFER_SIZE];
+    int threads_read = 0;
+    
+    for (;;) {
+        long nread = syscall(SYS_getdents64, task_fd, dents, sizeof(dents));
+        if (nread <= 0) break;
         
-        if (was_active) {
-            printf("[ALERTA DESPEJADA] PID: %d, Nombre: %s volvió a valores normales. CPU: %.2f%%, MEM: %.2f%%\n",
-                   info->pid, info->name, info->cpu_usage, info->mem_usage);
+        long offset = 0;
+        while (offset < nread) {
+            struct linux_dirent64 *entry = (struct linux_dirent64 *)((char *)dents + offset);
+            offset += entry->d_reclen;
+            
+            const char *c = entry->d_name;
+            if (*c < '1' || *c > '9') continue;
+            pid_t tid = 0;
+            while (*c >= '0' && *c <= '9') {
+                tid = tid * 10 + (*c - '0');
+                c++;
+            }
+            if (*c != '\0') continue;
+            
+            int tid_fd = openat(task_fd, entry->d_name, O_PATH | O_DIRECTORY | O_CLOEXEC);
+            if (tid_fd < 0) continue;
             
-            // Callback para alerta despejada
-            if (event_callbacks && event_callbacks->on_alert_cleared) {
-                event_callbacks->on_alert_cleared(info);
+            ProcSample task;
+            int ok = read_proc_sample_at(tid_fd, tid, &task, buf, sizeof(buf)) == 0;
+            close(tid_fd);
+            if (!ok) continue; // El hilo terminó durante el recorrido
+            threads_read++;
+            
+            float cpu = sample_cpu_usage(ctx, &task, info->pid);
+            if (cpu <= 0.0f) continue;
+            
+            // Inserción ordenada en la lista corta de hilos más activos
+            int pos = info->num_hot_threads;
+            if (pos == PROCESS_HOT_THREADS) {
+                if (cpu <= info->hot_threads[pos - 1].cpu_usage) continue;
+                pos--;
+            } else {
+                info->num_hot_threads++;
             }
+            while (pos > 0 && info->hot_threads[pos - 1].cpu_usage < cpu) {
+                info->hot_threads[pos] = info->hot_threads[pos - 1];
+                pos--;
+            }
+            info->hot_threads[pos].tid = tid;
+            info->hot_threads[pos].cpu_usage = cpu;
+            strncpy(info->hot_threads[pos].name, task.name, sizeof(info->hot_threads[pos].name) - 1);
+            info->hot_threads[pos].name[sizeof(info->hot_threads[pos].name) - 1] = '\0';
+        }
+    }
+    
+    close(task_fd);
+    return threads_read;
+}
+
+// ===== MUESTREO PARALELO DE /proc =====
+
+/**
+ * Lee las muestras de un fragmento de cycle_pids. Solo toca procfs y su
+ * propia porción de cycle_samples, por lo que es seguro en paralelo.
+ */
+static void sample_shard(int shard) {
+    char buf[STAT_BUFFER_SIZE];
+    int first = shard * SAMPLER_SHARD_SIZE;
+    int last = first + SAMPLER_SHARD_SIZE;
+    if (last > cycle_pids_count) last = cycle_pids_count;
+    
+    for (int i = first; i < last; i++) {
+        ProcSample *sample = &cycle_samples[i];
+        
+        // Los archivos del proceso se abren relativos a su directorio,
+        // sin resolver "/proc/[pid]/..." desde la raíz en cada apertura
+        int pid_fd = open_pid_dir(cycle_pids[i]);
+        if (pid_fd < 0) {
+            sample->pid = 0;
+            continue;
+        }
+        if (read_proc_sample_at(pid_fd, cycle_pids[i], sample, buf, sizeof(buf)) != 0) {
+            sample->pid = 0;
+        } else {
+            classify_sample_at(pid_fd, sample);
+            read_proc_io_at(pid_fd, sample, buf, sizeof(buf));
+            read_proc_pss_at(pid_fd, sample, &last_cycle_ctx);
+        }
+        close(pid_fd);
+    }
+}
+
+/**
+ * Reserva el siguiente fragmento pendiente del ciclo publicado
+ * 
+ * @return int: Índice del fragmento, o -1 si no quedan
+ */
+static int claim_shard(void) {
+    pthread_mutex_lock(&sampler_pool.lock);
+    int shard = -1;
+    if (sampler_pool.next_shard < sampler_pool.num_shards) {
+        shard = sampler_pool.next_shard++;
+    }
+    pthread_mutex_unlock(&sampler_pool.lock);
+    return shard;
+}
+
+static void* sampler_worker_function(void *arg) {
+    (void)arg;
+    unsigned int seen_job = 0;
+    
+    pthread_mutex_lock(&sampler_pool.lock);
+    seen_job = sampler_pool.job_id;
+    
+    while (1) {
+        while (!sampler_pool.shutdown && sampler_pool.job_id == seen_job) {
+            pthread_cond_wait(&sampler_pool.work_ready, &sampler_pool.lock);
+        }
+        if (sampler_pool.shutdown) break;
+        seen_job = sampler_pool.job_id;
+        pthread_mutex_unlock(&sampler_pool.lock);
+        
+        int shard;
+        while ((shard = claim_shard()) >= 0) {
+            sample_shard(shard);
+        }
+        
+        pthread_mutex_lock(&sampler_pool.lock);
+        if (--sampler_pool.busy_workers == 0) {
+            pthread_cond_signal(&sampler_pool.work_done);
+        }
+    }
+    
+    pthread_mutex_unlock(&sampler_pool.lock);
+    return NULL;
+}
+
+/**
+ * Crea los hilos auxiliares del pool si hacen falta. Con sampler_threads == N
+ * se crean N-1 auxiliares, ya que el hilo de monitoreo también muestrea.
+ */
+static void sampler_pool_ensure(int num_helpers) {
+    // Se compara con lo pedido y no con lo creado: si pthread_create falló a
+    // medias, el pool se queda con los hilos que haya en lugar de rehacerse
+    // en cada ciclo
+    if (sampler_pool.target_threads == num_helpers) return;
+    
+    sampler_pool_stop();
+    sampler_pool.target_threads = num_helpers;
+    
+    pthread_mutex_lock(&sampler_pool.lock);
+    sampler_pool.shutdown = 0;
+    pthread_mutex_unlock(&sampler_pool.lock);
+    
+    for (int i = 0; i < num_helpers; i++) {
+        int result = pthread_create(&sampler_pool.threads[i], NULL, sampler_worker_function, NULL);
+        if (result != 0) {
+            fprintf(stderr, "[ERROR] No se pudo crear hilo de muestreo: %d\n", result);
+            break;
+        }
+        sampler_pool.num_threads++;
+    }
+    
+    if (sampler_pool.num_threads > 0) {
+        monitor_log("[INFO] Muestreo de /proc con %d hilos\n", sampler_pool.num_threads + 1);
+    }
+}
+
+static void sampler_pool_stop(void) {
+    sampler_pool.target_threads = 0;
+    if (sampler_pool.num_threads == 0) return;
+    
+    pthread_mutex_lock(&sampler_pool.lock);
+    sampler_pool.shutdown = 1;
+    pthread_cond_broadcast(&sampler_pool.work_ready);
+    pthread_mutex_unlock(&sampler_pool.lock);
+    
+    for (int i = 0; i < sampler_pool.num_threads; i++) {
+        pthread_join(sampler_pool.threads[i], NULL);
+    }
+    sampler_pool.num_threads = 0;
+}
+
+/**
+ * Quita de cycle_pids los procesos ya registrados cuya próxima lectura aún
+ * no toca (niveles lento y rápido), según la programación de
+ * schedule_next_sample(). Siguen apareciendo en /proc, así que se marcan como
+ * encontrados y conservan sus últimos valores.
+ * 
+ * Un PID reutilizado entre dos lecturas de un proceso lento se detecta en su
+ * siguiente lectura por el cambio de starttime; con el conector de procesos
+ * activo la salida del anterior ya lo habrá retirado.
+ * 
+ * @return int: Número de procesos omitidos en este ciclo
+ */
+static int select_due_pids(const CycleContext *ctx) {
+    // Margen de medio intervalo para no saltar un ciclo por milisegundos
+    struct timespec horizon = ctx->now;
+    timespec_add_ms(&horizon, (long)config.check_interval * 500);
+    
+    int kept = 0;
+    int skipped = 0;
+    for (int p = 0; p < cycle_pids_count; p++) {
+        int idx = find_process(cycle_pids[p]);
+        if (idx != -1 && timespec_before(&horizon, &procesos_activos[idx].next_sample)) {
+            proc_columns.flags[idx] |= SLOT_FOUND | SLOT_SKIPPED;
+            cpu_sample_touch(cycle_pids[p], proc_columns.starttime[idx]);
+            skipped++;
+            continue;
+        }
+        cycle_pids[kept++] = cycle_pids[p];
+    }
+    
+    cycle_pids_count = kept;
+    return skipped;
+}
+
+/**
+ * Lee la muestra de cada PID de cycle_pids en cycle_samples. Con más de un
+ * hilo configurado reparte los fragmentos entre el pool y el hilo actual.
+ * 
+ * @return int: 0 si es exitoso, -1 si no hay memoria para las muestras
+ */
+static int sample_cycle_pids(void) {
+    if (cycle_pids_count > cycle_samples_capacity) {
+        int new_capacity = cycle_samples_capacity ? cycle_samples_capacity : 1024;
+        while (new_capacity < cycle_pids_count) new_capacity *= 2;
+        
+        ProcSample *temp = realloc(cycle_samples, (size_t)new_capacity * sizeof(ProcSample));
+        if (!temp) {
+            fprintf(stderr, "[ERROR] No se pudo asignar memoria para las muestras del ciclo\n");
+            return -1;
         }
+        cycle_samples = temp;
+        cycle_samples_capacity = new_capacity;
+    }
+    
+    int num_shards = (cycle_pids_count + SAMPLER_SHARD_SIZE - 1) / SAMPLER_SHARD_SIZE;
+    
+    sampler_pool_ensure(config.sampler_threads - 1);
+    
+    if (sampler_pool.num_threads == 0 || num_shards <= 1) {
+        for (int shard = 0; shard < num_shards; shard++) {
+            sample_shard(shard);
+        }
+        return 0;
+    }
+    
+    // Publicar el ciclo y participar en él
+    pthread_mutex_lock(&sampler_pool.lock);
+    sampler_pool.next_shard = 0;
+    sampler_pool.num_shards = num_shards;
+    sampler_pool.busy_workers = sampler_pool.num_threads;
+    sampler_pool.job_id++;
+    pthread_cond_broadcast(&sampler_pool.work_ready);
+    pthread_mutex_unlock(&sampler_pool.lock);
+    
+    int shard;
+    while ((shard = claim_shard()) >= 0) {
+        sample_shard(shard);
+    }
+    
+    // Esperar a que los auxiliares terminen sus fragmentos
+    pthread_mutex_lock(&sampler_pool.lock);
+    while (sampler_pool.busy_workers > 0) {
+        pthread_cond_wait(&sampler_pool.work_done, &sampler_pool.lock);
+    }
+    pthread_mutex_unlock(&sampler_pool.lock);
+    
+    return 0;
+}
+
+/**
+ * Abre el directorio /proc/[pid] para usarlo como base de openat()
+ * 
+ * @return int: Descriptor (O_PATH) que el llamador debe cerrar, o -1 si el proceso no existe
+ */
+static int open_pid_dir(pid_t pid) {
+    char name[32];
+    snprintf(name, sizeof(name), "%d", pid);
+    
+    if (proc_dir_fd >= 0) {
+        return openat(proc_dir_fd, name, O_PATH | O_DIRECTORY | O_CLOEXEC);
+    }
+    
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%s", name);
+    return open(path, O_PATH | O_DIRECTORY | O_CLOEXEC);
+}
+
+/**
+ * Lee un archivo completo de procfs relativo a un directorio con una sola
+ * llamada a read(). El contenido queda terminado en '\0'.
+ * 
+ * @return ssize_t: Bytes leídos, o -1 si hay error
+ */
+static ssize_t read_file_at(int dir_fd, const char *name, char *buf, size_t buf_size) {
+    int fd = openat(dir_fd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    ssize_t len = read(fd, buf, buf_size - 1);
+    close(fd);
+    if (len <= 0) return -1;
+    buf[len] = '\0';
+    return len;
+}
+
+/**
+ * Versión de read_proc_sample_at() para llamadas sueltas fuera del ciclo
+ */
+static int read_proc_sample(pid_t pid, ProcSample *sample, char *buf, size_t buf_size) {
+    int pid_fd = open_pid_dir(pid);
+    if (pid_fd < 0) return -1;
+    int result = read_proc_sample_at(pid_fd, pid, sample, buf, buf_size);
+    if (result == 0) {
+        classify_sample_at(pid_fd, sample);
     }
+    close(pid_fd);
+    return result;
+}
+
+/**
+ * Lee /proc/[pid]/stat con una sola llamada a read() y extrae en una pasada
+ * nombre, estado, ppid, utime, stime, starttime, vsize y rss.
+ * 
+ * El campo comm va entre paréntesis y puede contener espacios o paréntesis,
+ * por lo que se delimita con el primer '(' y el ÚLTIMO ')' de la línea.
+ * 
+ * @param pid_fd: Descriptor de /proc/[pid] obtenido con open_pid_dir()
+ * @param buf: Buffer de trabajo reutilizable provisto por el llamador
+ * @return 0 si es exitoso, -1 si el proceso no existe o el formato es inválido
+ */
+static int read_proc_sample_at(int pid_fd, pid_t pid, ProcSample *sample, char *buf, size_t buf_size) {
+    if (read_file_at(pid_fd, "stat", buf, buf_size) < 0) return -1;
+    
+    char *open_paren = strchr(buf, '(');
+    char *close_paren = strrchr(buf, ')');
+    if (!open_paren || !close_paren || close_paren < open_paren) return -1;
+    
+    memset(sample, 0, sizeof(ProcSample));
+    sample->pid = pid;
+    
+    size_t name_len = (size_t)(close_paren - open_paren - 1);
+    if (name_len >= sizeof(sample->name)) name_len = sizeof(sample->name) - 1;
+    memcpy(sample->name, open_paren + 1, name_len);
+    sample->name[name_len] = '\0';
+    
+    // Campo 3 (state) sigue a ") "
+    char *p = close_paren + 1;
+    while (*p == ' ') p++;
+    if (*p == '\0') return -1;
+    sample->state = *p++;
+    
+    // Campos 4 (ppid) a 24 (rss), todos numéricos
+    long long fields[21];
+    for (int i = 0; i < 21; i++) {
+        char *end;
+        fields[i] = strtoll(p, &end, 10);
+        if (end == p) return -1;
+        p = end;
+    }
+    
+    sample->ppid = (pid_t)fields[4 - 4];
+    sample->utime = (unsigned long)fields[14 - 4];
+    sample->stime = (unsigned long)fields[15 - 4];
+    sample->starttime = (unsigned long)fields[22 - 4];
+    sample->vsize = (unsigned long)fields[23 - 4];
+    sample->rss = (long)fields[24 - 4];
+    
+    clock_gettime(CLOCK_MONOTONIC, &sample->taken);
+    return 0;
+}
+
+/**
+ * Resuelve la whitelist para la muestra. El veredicto se memoriza por
+ * (pid, starttime), así que exe y cmdline se leen como mucho una vez
+ * por proceso.
+ */
+static void classify_sample_at(int pid_fd, ProcSample *sample) {
+    sample->whitelisted = whitelist_match_process(pid_fd, sample->pid,
+                                                  sample->starttime, sample->name);
 }
 
-// ===== FUNCIONES DE ACCESO A /proc =====
-
-static int read_proc_stat(pid_t pid, ProcStat *stat) {
-    char stat_path[256];
-    sprintf(stat_path, "/proc/%d/stat", pid);
-    FILE *fp = fopen(stat_path, "r");
-    if (!fp) return -1;    
-    
-    // Leer los campos 14 (utime), 15 (stime), 22 (starttime)
-    int scanned = fscanf(fp,
-        "%*d "      // pid (campo 1)
-        "%*s "      // comm (campo 2)
-        "%*c "      // state (campo 3)
-        "%*d %*d %*d %*d %*d "  // campos 4-8
-        "%*u %*u %*u %*u %*u "  // campos 9-13
-        "%lu %lu %*ld %*ld %*ld %*ld %*ld %*ld %lu",  // campos 14, 15, 16-21, 22
-        &stat->utime, &stat->stime, &stat->starttime);
+/**
+ * Lee los contadores de /proc/[pid]/io (syscr, syscw, read_bytes, write_bytes).
+ * Se omite para procesos en whitelist, que nunca generan alertas. El archivo
+ * solo es legible para procesos propios o con CAP_SYS_PTRACE; si no se puede
+ * leer, la muestra queda sin datos de E/S.
+ */
+static void read_proc_io_at(int pid_fd, ProcSample *sample, char *buf, size_t buf_size) {
+    sample->has_io = 0;
+    if (sample->whitelisted) return;
+    if (read_file_at(pid_fd, "io", buf, buf_size) < 0) return;
+    
+    char *field;
+    if ((field = strstr(buf, "syscr: ")) != NULL) sample->syscr = strtoull(field + 7, NULL, 10);
+    if ((field = strstr(buf, "syscw: ")) != NULL) sample->syscw = strtoull(field + 7, NULL, 10);
+    if ((field = strstr(buf, "read_bytes: ")) != NULL) sample->read_bytes = strtoull(field + 12, NULL, 10);
+    // La primera aparición es write_bytes; cancelled_write_bytes va después
+    if ((field = strstr(buf, "write_bytes: ")) != NULL) sample->write_bytes = strtoull(field + 13, NULL, 10);
+    sample->has_io = 1;
+}
 
-    fclose(fp);
-    return (scanned == 3) ? 0 : -1;
+/**
+ * Segundo nivel de la medición de memoria: lee Pss y Swap de smaps_rollup.
+ * Recorrer las regiones del proceso es caro, así que solo se hace cuando el
+ * RSS de stat supera ctx->pss_min_rss_kb; el PSS reparte las páginas
+ * compartidas entre sus usuarios y evita contarlas varias veces en
+ * aplicaciones multiproceso. Si el archivo no es legible se conserva el RSS.
+ */
+static void read_proc_pss_at(int pid_fd, ProcSample *sample, const CycleContext *ctx) {
+    sample->has_pss = 0;
+    if (ctx->pss_min_rss_kb == 0 || sample->rss <= 0) return;
+    if ((unsigned long)sample->rss * (unsigned long)ctx->page_size_kb < ctx->pss_min_rss_kb) return;
+    if (sample->whitelisted) return;
+    
+    char buf[SMAPS_BUFFER_SIZE];
+    if (read_file_at(pid_fd, "smaps_rollup", buf, sizeof(buf)) < 0) return;
+    
+    // Las claves van al inicio de línea: "\nPss:" no coincide con Pss_Anon ni SwapPss
+    char *pss = strstr(buf, "\nPss:");
+    if (!pss) return;
+    sample->pss_kb = strtoul(pss + 5, NULL, 10);
+    
+    char *swap = strstr(buf, "\nSwap:");
+    sample->swap_kb = swap ? strtoul(swap + 6, NULL, 10) : 0;
+    sample->has_pss = 1;
 }
 
 static unsigned long get_total_system_memory(void) {
@@ -775,132 +3210,390 @@ static unsigned long get_total_system_memory(void) {
     return total_mem;
 }
 
-// ===== FUNCIONES DE PERSISTENCIA =====
+/**
+ * Captura las constantes del sistema que comparten todos los procesos de un
+ * ciclo, de modo que el costo por proceso se limite a sus propias lecturas.
+ */
+static void capture_cycle_context(CycleContext *ctx) {
+    memset(ctx, 0, sizeof(CycleContext));
+    
+    ctx->mem_total_kb = get_total_system_memory();
+    ctx->clk_tck = sysconf(_SC_CLK_TCK);
+    ctx->num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    ctx->page_size_kb = sysconf(_SC_PAGESIZE) / 1024;
+    if (ctx->num_cpus < 1) ctx->num_cpus = 1;
+    
+    FILE *uptime_fp = fopen("/proc/uptime", "r");
+    if (uptime_fp) {
+        if (fscanf(uptime_fp, "%lf", &ctx->uptime_seconds) != 1) {
+            ctx->uptime_seconds = 0.0;
+        }
+        fclose(uptime_fp);
+    }
+    
+    // Solo los procesos cuyo RSS ya se acerca al umbral pagan la lectura de
+    // smaps_rollup, y ninguno mientras el sistema está bajo presión
+    if (config.pss_fraction > 0.0f && config.max_ram_usage > 0.0f &&
+        pressure_state.level == LOAD_LEVEL_NORMAL) {
+        ctx->pss_min_rss_kb = (unsigned long)(ctx->mem_total_kb *
+            (config.max_ram_usage / 100.0) * config.pss_fraction);
+        if (ctx->pss_min_rss_kb == 0) ctx->pss_min_rss_kb = 1;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &ctx->now);
+}
+
+// ===== TABLA DE MUESTRAS DE CPU =====
 
-static void get_stat_file_path(pid_t pid, char *path, size_t size) {
-    snprintf(path, size, "/tmp/procstat_%d.dat", pid);
+/**
+ * Calcula la posición inicial de una clave (pid, starttime) en la tabla.
+ * La capacidad es potencia de 2, por lo que basta con una máscara.
+ */
+static size_t cpu_sample_hash(pid_t pid, unsigned long starttime, int is_task) {
+    unsigned long h = (unsigned long)(unsigned int)pid * 2654435761UL + (unsigned long)is_task;
+    h ^= starttime + 0x9e3779b9UL + (h << 6) + (h >> 2);
+    return (size_t)h & (cpu_samples_capacity - 1);
 }
 
-static void read_prev_times(pid_t pid, unsigned long *prev_user_time, unsigned long *prev_sys_time) {
-    char path[64];
-    get_stat_file_path(pid, path, sizeof(path));
-    FILE *f = fopen(path, "r");
-    if (f) {
-        int scanned = fscanf(f, "%lu %lu", prev_user_time, prev_sys_time);
-        fclose(f);
-        
-        // Si no se pudieron leer ambos valores, inicializar a 0
-        if (scanned != 2) {
-            *prev_user_time = 0;
-            *prev_sys_time = 0;
+/**
+ * Redimensiona la tabla al doble de capacidad reinsertando las entradas.
+ * 
+ * @return 0 si es exitoso, -1 si no hay memoria
+ */
+static int cpu_sample_grow(void) {
+    size_t new_capacity = cpu_samples_capacity ? cpu_samples_capacity * 2
+                                               : CPU_SAMPLE_INITIAL_CAPACITY;
+    CpuSample *new_table = calloc(new_capacity, sizeof(CpuSample));
+    if (!new_table) {
+        fprintf(stderr, "[ERROR] No se pudo expandir la tabla de muestras de CPU\n");
+        return -1;
+    }
+    
+    CpuSample *old_table = cpu_samples;
+    size_t old_capacity = cpu_samples_capacity;
+    cpu_samples = new_table;
+    cpu_samples_capacity = new_capacity;
+    
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (!old_table[i].used) continue;
+        size_t pos = cpu_sample_hash(old_table[i].pid, old_table[i].starttime, old_table[i].is_task);
+        while (cpu_samples[pos].used) {
+            pos = (pos + 1) & (cpu_samples_capacity - 1);
         }
-    } else {
-        *prev_user_time = 0;
-        *prev_sys_time = 0;
+        cpu_samples[pos] = old_table[i];
     }
+    
+    free(old_table);
+    return 0;
 }
 
-static void write_prev_times(pid_t pid, unsigned long prev_user_time, unsigned long prev_sys_time) {
-    char path[64];
-    get_stat_file_path(pid, path, sizeof(path));
-    FILE *f = fopen(path, "w");
-    if (f) {
-        fprintf(f, "%lu %lu\n", prev_user_time, prev_sys_time);
-        fclose(f);
+/**
+ * Busca la muestra previa de un proceso o hilo, creándola si no existe.
+ * Marca la entrada con la generación del ciclo actual para que no sea
+ * descartada por cpu_sample_sweep(). El hilo principal comparte PID y
+ * starttime con su proceso, por eso is_task forma parte de la clave.
+ * 
+ * @param is_task: 1 para la muestra de un hilo
+ * @param is_new: Se pone a 1 si la entrada se acaba de crear (sin muestra previa)
+ * @return CpuSample*: Entrada de la tabla, o NULL si no hay memoria
+ */
+static CpuSample* cpu_sample_lookup(pid_t pid, unsigned long starttime, int is_task, int *is_new) {
+    *is_new = 0;
+    
+    // Mantener factor de carga por debajo de 3/4
+    if ((cpu_samples_count + 1) * 4 > cpu_samples_capacity * 3) {
+        if (cpu_sample_grow() != 0) return NULL;
+    }
+    
+    size_t pos = cpu_sample_hash(pid, starttime, is_task);
+    while (cpu_samples[pos].used) {
+        if (cpu_samples[pos].pid == pid && cpu_samples[pos].starttime == starttime &&
+            cpu_samples[pos].is_task == is_task) {
+            cpu_samples[pos].generation = cpu_sample_generation;
+            return &cpu_samples[pos];
+        }
+        pos = (pos + 1) & (cpu_samples_capacity - 1);
+    }
+    
+    // Entrada nueva
+    memset(&cpu_samples[pos], 0, sizeof(CpuSample));
+    cpu_samples[pos].used = 1;
+    cpu_samples[pos].pid = pid;
+    cpu_samples[pos].starttime = starttime;
+    cpu_samples[pos].is_task = is_task;
+    cpu_samples[pos].generation = cpu_sample_generation;
+    cpu_samples_count++;
+    *is_new = 1;
+    return &cpu_samples[pos];
+}
+
+/**
+ * Marca como vigente la muestra de un proceso que no se leyó en este ciclo,
+ * para que cpu_sample_sweep() no la descarte. No crea entradas.
+ */
+static void cpu_sample_touch(pid_t pid, unsigned long starttime) {
+    if (!cpu_samples) return;
+    
+    size_t pos = cpu_sample_hash(pid, starttime, 0);
+    while (cpu_samples[pos].used) {
+        if (cpu_samples[pos].pid == pid && cpu_samples[pos].starttime == starttime &&
+            !cpu_samples[pos].is_task) {
+            cpu_samples[pos].generation = cpu_sample_generation;
+            return;
+        }
+        pos = (pos + 1) & (cpu_samples_capacity - 1);
+    }
+}
+
+/**
+ * Elimina la entrada en la posición indicada usando desplazamiento hacia
+ * atrás, de modo que la tabla nunca necesita marcas de borrado.
+ */
+static void cpu_sample_delete_at(size_t pos) {
+    size_t mask = cpu_samples_capacity - 1;
+    size_t hole = pos;
+    size_t next = (pos + 1) & mask;
+    
+    while (cpu_samples[next].used) {
+        size_t home = cpu_sample_hash(cpu_samples[next].pid, cpu_samples[next].starttime,
+                                      cpu_samples[next].is_task);
+        // Mover la entrada al hueco solo si su posición ideal no está entre hole y next
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            cpu_samples[hole] = cpu_samples[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    
+    cpu_samples[hole].used = 0;
+    cpu_samples_count--;
+}
+
+/**
+ * Descarta las muestras que no se consultaron en el ciclo actual, es decir,
+ * las de procesos que desaparecieron o cuyo PID fue reutilizado. Las de hilos
+ * de un proceso omitido por select_due_pids() se conservan, para que su CPU%
+ * siga siendo un delta cuando el proceso vuelva a leerse.
+ */
+static void cpu_sample_sweep(void) {
+    if (!cpu_samples || cpu_samples_count == 0) return;
+    
+    size_t mask = cpu_samples_capacity - 1;
+    
+    // Empezar justo después de una ranura vacía: ningún grupo de colisiones
+    // cruza ese punto, así que los desplazamientos de cpu_sample_delete_at()
+    // nunca mueven entradas a posiciones ya recorridas
+    size_t start = 0;
+    while (cpu_samples[start].used) {
+        start = (start + 1) & mask;
+    }
+    
+    size_t pos = (start + 1) & mask;
+    for (size_t visited = 0; visited < cpu_samples_capacity; visited++) {
+        while (cpu_samples[pos].used && cpu_samples[pos].generation != cpu_sample_generation) {
+            if (cpu_samples[pos].is_task) {
+                int idx = find_process(cpu_samples[pos].owner);
+                if (idx != -1 && (proc_columns.flags[idx] & SLOT_SKIPPED)) {
+                    cpu_samples[pos].generation = cpu_sample_generation;
+                    break;
+                }
+            }
+            cpu_sample_delete_at(pos);
+        }
+        pos = (pos + 1) & mask;
     }
 }
 
+static void cpu_sample_table_clear(void) {
+    free(cpu_samples);
+    cpu_samples = NULL;
+    cpu_samples_capacity = 0;
+    cpu_samples_count = 0;
+}
+
 // ===== FUNCIONES DE CÁLCULO DE RECURSOS =====
 
 float total_cpu_usage(pid_t pid) {
-    ProcStat stat;
-    if (read_proc_stat(pid, &stat) != 0) return 0.0;
-    
-    // Obtener uptime del sistema en segundos
-    FILE *uptime_fp = fopen("/proc/uptime", "r");
-    if (!uptime_fp) return 0.0;
-    double system_uptime_seconds = 0.0;
-    fscanf(uptime_fp, "%lf", &system_uptime_seconds);
-    fclose(uptime_fp);
+    char buf[STAT_BUFFER_SIZE];
+    ProcSample sample;
+    if (read_proc_sample(pid, &sample, buf, sizeof(buf)) != 0) return 0.0;
+    CycleContext ctx;
+    capture_cycle_context(&ctx);
+    return lifetime_cpu_usage(&ctx, &sample);
+}
+
+float interval_cpu_usage(pid_t pid) {
+    char buf[STAT_BUFFER_SIZE];
+    ProcSample sample;
+    if (read_proc_sample(pid, &sample, buf, sizeof(buf)) != 0) return 0.0;
+    CycleContext ctx;
+    capture_cycle_context(&ctx);
+    return sample_cpu_usage(&ctx, &sample, 0);
+}
 
-    long clk_tck = sysconf(_SC_CLK_TCK);
+float get_process_memory_usage(pid_t pid) {
+    char buf[STAT_BUFFER_SIZE];
+    ProcSample sample;
+    int pid_fd = open_pid_dir(pid);
+    if (pid_fd < 0) return 0.0;
+    if (read_proc_sample_at(pid_fd, pid, &sample, buf, sizeof(buf)) != 0) {
+        close(pid_fd);
+        return 0.0;
+    }
+    CycleContext ctx;
+    capture_cycle_context(&ctx);
+    classify_sample_at(pid_fd, &sample);
+    read_proc_pss_at(pid_fd, &sample, &ctx);
+    close(pid_fd);
+    return sample_memory_usage(&ctx, &sample);
+}
+
+/**
+ * Uso de CPU promedio desde que arrancó el proceso
+ */
+static float lifetime_cpu_usage(const CycleContext *ctx, const ProcSample *sample) {
+    if (ctx->clk_tck <= 0 || ctx->uptime_seconds <= 0) return 0.0;
     
     // Calcular tiempo que el proceso ha estado vivo en segundos
-    double process_start_time_seconds = stat.starttime / (double)clk_tck;
-    double process_uptime_seconds = system_uptime_seconds - process_start_time_seconds;
+    double process_start_time_seconds = sample->starttime / (double)ctx->clk_tck;
+    double process_uptime_seconds = ctx->uptime_seconds - process_start_time_seconds;
     
     if (process_uptime_seconds <= 0) return 0.0;
     
     // Convertir tiempo de CPU usado a segundos
-    double cpu_time_seconds = (stat.utime + stat.stime) / (double)clk_tck;
+    double cpu_time_seconds = (sample->utime + sample->stime) / (double)ctx->clk_tck;
     
     // Calcular porcentaje: (tiempo_cpu_usado / tiempo_vida_proceso) * 100
     return (float)(100.0 * (cpu_time_seconds / process_uptime_seconds));
 }
 
-float interval_cpu_usage(pid_t pid) {
-    ProcStat stat;
-    if (read_proc_stat(pid, &stat) != 0) return 0.0;
-
-    unsigned long prev_user_time = 0, prev_sys_time = 0;
-    read_prev_times(pid, &prev_user_time, &prev_sys_time);
-
-    // Verificar consistencia de datos (proceso reiniciado, overflow, etc.)
-    if ((prev_user_time == 0 && prev_sys_time == 0) ||
-        (stat.utime < prev_user_time || stat.stime <  prev_sys_time))
-    {
-        write_prev_times(pid, stat.utime, stat.stime);
-        return total_cpu_usage(pid);
-    }    
-    
-    unsigned long delta_user = stat.utime - prev_user_time;
-    unsigned long delta_sys = stat.stime - prev_sys_time;
-    unsigned long delta_total = delta_user + delta_sys;
-    long clk_tck = sysconf(_SC_CLK_TCK);
+/**
+ * Tasas de E/S desde la lectura previa de /proc/[pid]/io, guardada en la
+ * misma entrada de la tabla de muestras que los tiempos de CPU
+ */
+static void sample_io_rates(const ProcSample *sample, ProcessInfo *info) {
+    if (!sample->has_io) return;
+    
+    int is_new = 0;
+    CpuSample *prev = cpu_sample_lookup(sample->pid, sample->starttime, 0, &is_new);
+    if (!prev) return;
+    
+    double elapsed = (sample->taken.tv_sec - prev->io_timestamp.tv_sec) +
+                     (sample->taken.tv_nsec - prev->io_timestamp.tv_nsec) / 1e9;
+    
+    // Lecturas casi simultáneas: conservar las tasas y los contadores previos
+    if (!prev->has_io || elapsed >= CPU_SAMPLE_MIN_ELAPSED) {
+        if (prev->has_io &&
+            sample->read_bytes >= prev->prev_read_bytes &&
+            sample->write_bytes >= prev->prev_write_bytes &&
+            sample->syscr >= prev->prev_syscr && sample->syscw >= prev->prev_syscw) {
+            prev->last_read_kbps = (float)((sample->read_bytes - prev->prev_read_bytes) / 1024.0 / elapsed);
+            prev->last_write_kbps = (float)((sample->write_bytes - prev->prev_write_bytes) / 1024.0 / elapsed);
+            prev->last_syscr_rate = (float)((sample->syscr - prev->prev_syscr) / elapsed);
+            prev->last_syscw_rate = (float)((sample->syscw - prev->prev_syscw) / elapsed);
+        } else {
+            // Sin lectura previa no hay tasa todavía
+            prev->last_read_kbps = 0.0f;
+            prev->last_write_kbps = 0.0f;
+            prev->last_syscr_rate = 0.0f;
+            prev->last_syscw_rate = 0.0f;
+        }
+        
+        prev->prev_read_bytes = sample->read_bytes;
+        prev->prev_write_bytes = sample->write_bytes;
+        prev->prev_syscr = sample->syscr;
+        prev->prev_syscw = sample->syscw;
+        prev->io_timestamp = sample->taken;
+        prev->has_io = 1;
+    }
+    
+    info->io_read_kbps = prev->last_read_kbps;
+    info->io_write_kbps = prev->last_write_kbps;
+    info->syscr_rate = prev->last_syscr_rate;
+    info->syscw_rate = prev->last_syscw_rate;
+    info->io_kbps = info->io_read_kbps + info->io_write_kbps;
+}
+
+/**
+ * Uso de CPU en el intervalo desde la muestra previa guardada en memoria
+ * 
+ * @param owner: 0 para un proceso; para un hilo (task/[tid]/stat), el PID
+ *               del proceso al que pertenece
+ */
+static float sample_cpu_usage(const CycleContext *ctx, const ProcSample *sample, pid_t owner) {
+    int is_new = 0;
+    CpuSample *prev = cpu_sample_lookup(sample->pid, sample->starttime, owner != 0, &is_new);
+    if (!prev) return lifetime_cpu_usage(ctx, sample);
+    prev->owner = owner;
+
+    // Tiempo real transcurrido entre las dos lecturas (reloj monótono)
+    double elapsed = (sample->taken.tv_sec - prev->timestamp.tv_sec) +
+                     (sample->taken.tv_nsec - prev->timestamp.tv_nsec) / 1e9;
+    
+    // Dos lecturas casi simultáneas (p. ej. un evento del conector justo
+    // después del ciclo) no tienen resolución: conservar la medición previa
+    if (!is_new && elapsed >= 0.0 && elapsed < CPU_SAMPLE_MIN_ELAPSED) {
+        return prev->last_cpu_usage;
+    }
+
+    unsigned long prev_user_time = prev->prev_utime;
+    unsigned long prev_sys_time = prev->prev_stime;
 
     // Guardar tiempos actuales para próxima medición
-    write_prev_times(pid, stat.utime, stat.stime);
+    prev->prev_utime = sample->utime;
+    prev->prev_stime = sample->stime;
+    prev->timestamp = sample->taken;
+
+    // Verificar consistencia de datos (sin muestra previa, overflow, etc.)
+    if (is_new || elapsed <= 0.0 || sample->utime < prev_user_time || sample->stime < prev_sys_time) {
+        prev->last_cpu_usage = lifetime_cpu_usage(ctx, sample);
+        return prev->last_cpu_usage;
+    }
+    
+    unsigned long delta_user = sample->utime - prev_user_time;
+    unsigned long delta_sys = sample->stime - prev_sys_time;
+    unsigned long delta_total = delta_user + delta_sys;
 
-    // Calcular porcentaje de CPU
-    double cpu_percentage = 100.0 * (delta_total / ((double)clk_tck * config.check_interval));
+    // Calcular porcentaje de CPU sobre el tiempo que realmente pasó
+    double cpu_percentage = 100.0 * (delta_total / ((double)ctx->clk_tck * elapsed));
     
     // Detectar valores extremadamente altos que indican problemas de datos
-    long num_cores = sysconf(_SC_NPROCESSORS_ONLN);
+    long num_cores = ctx->num_cpus;
     double max_theoretical_cpu = num_cores * 100.0;
     
+    // En ventanas cortas la granularidad de los ticks (utime y stime se
+    // redondean por separado) puede pasar del máximo en un par de ticks
+    double tick_error = 100.0 * 2.0 / ((double)ctx->clk_tck * elapsed);
+    if (cpu_percentage > max_theoretical_cpu &&
+        cpu_percentage <= max_theoretical_cpu + tick_error) {
+        cpu_percentage = max_theoretical_cpu;
+    }
+    
     if (cpu_percentage > max_theoretical_cpu) {
         fprintf(stderr, "[WARNING] PID %d: CPU calculation suspicious: %.2f%% "
                 "(max theoretical: %.2f%% for %ld cores)\n", 
-                pid, cpu_percentage, max_theoretical_cpu, num_cores);
-        return total_cpu_usage(pid);
+                sample->pid, cpu_percentage, max_theoretical_cpu, num_cores);
+        prev->last_cpu_usage = lifetime_cpu_usage(ctx, sample);
+        return prev->last_cpu_usage;
     }
     
-    return (float)cpu_percentage;
+    prev->last_cpu_usage = (float)cpu_percentage;
+    return prev->last_cpu_usage;
 }
 
-float get_process_memory_usage(pid_t pid) {
-    char status_path[256];
-    sprintf(status_path, "/proc/%d/status", pid);
-    FILE *fp = fopen(status_path, "r");
-    if (!fp) return 0.0;
-    
-    char line[256];
-    unsigned long vmrss = 0; // Memoria física usada
-    
-    while (fgets(line, sizeof(line), fp)) {
-        if (strstr(line, "VmRSS:")) {
-            sscanf(line, "VmRSS: %lu kB", &vmrss);
-            break;
-        }
-    }
-    fclose(fp);
-    
-    if (vmrss == 0) return 0.0;
+/**
+ * Porcentaje de memoria física usada. Se calcula con PSS cuando la muestra
+ * se escaló a smaps_rollup y con el rss de stat en el resto de los casos.
+ */
+static float sample_memory_usage(const CycleContext *ctx, const ProcSample *sample) {
+    if (sample->rss <= 0) return 0.0;
     
-    unsigned long total_mem = get_total_system_memory();
+    unsigned long total_mem = ctx->mem_total_kb;
     if (total_mem == 0) return 0.0;
     
-    float mem_percentage = (float)(100.0 * vmrss / total_mem);
+    unsigned long used_kb = sample->has_pss ? sample->pss_kb :
+                            (unsigned long)sample->rss * (unsigned long)ctx->page_size_kb;
+    float mem_percentage = (float)(100.0 * used_kb / total_mem);
     
     // Validación: la memoria nunca debería exceder 100%
     if (mem_percentage > 100.0) {
@@ -912,74 +3605,434 @@ float get_process_memory_usage(pid_t pid) {
 
 // ===== FUNCIONES DE GESTIÓN DE PROCESOS =====
 
+static size_t pid_index_hash(pid_t pid) {
+    return ((size_t)(unsigned int)pid * 2654435761u) & (pid_index_capacity - 1);
+}
+
+/**
+ * Reconstruye el índice con la capacidad indicada a partir del slab
+ * 
+ * @return 0 si es exitoso, -1 si no hay memoria
+ */
+static int pid_index_rebuild(size_t new_capacity) {
+    PidIndexEntry *new_index = calloc(new_capacity, sizeof(PidIndexEntry));
+    if (!new_index) {
+        fprintf(stderr, "[ERROR] No se pudo expandir el índice de procesos\n");
+        return -1;
+    }
+    
+    free(pid_index);
+    pid_index = new_index;
+    pid_index_capacity = new_capacity;
+    pid_index_count = 0;
+    
+    for (int i = 0; i < procesos_high_water; i++) {
+        if (!(proc_columns.flags[i] & SLOT_IN_USE)) continue;
+        size_t pos = pid_index_hash(proc_columns.pid[i]);
+        while (pid_index[pos].pid != 0) {
+            pos = (pos + 1) & (pid_index_capacity - 1);
+        }
+        pid_index[pos].pid = proc_columns.pid[i];
+        pid_index[pos].slot = i;
+        pid_index_count++;
+    }
+    return 0;
+}
+
+/**
+ * Busca la ranura de un PID en O(1) usando el índice hash
+ * 
+ * @return int: Índice en procesos_activos, o -1 si no se encuentra
+ */
 static int find_process(pid_t pid) {
-    for (int i = 0; i < num_procesos_activos; i++) {
-        if (procesos_activos[i].info.pid == pid) {
-            return i;
+    if (!pid_index) return -1;
+    
+    size_t pos = pid_index_hash(pid);
+    while (pid_index[pos].pid != 0) {
+        if (pid_index[pos].pid == pid) {
+            return pid_index[pos].slot;
         }
+        pos = (pos + 1) & (pid_index_capacity - 1);
     }
     return -1;
 }
 
-static void add_process(ProcessInfo info) {
-    // Usar temp pointer para evitar perder referencia en caso de fallo de realloc
-    ActiveProcess *temp_array = realloc(procesos_activos, 
-                                       (num_procesos_activos + 1) * sizeof(ActiveProcess));
+static int pid_index_insert(pid_t pid, int slot) {
+    // Mantener factor de carga por debajo de 1/2 para sondeos cortos
+    if ((pid_index_count + 1) * 2 > pid_index_capacity) {
+        size_t new_capacity = pid_index_capacity ? pid_index_capacity * 2
+                                                 : (size_t)PROCESS_SLAB_INITIAL_CAPACITY * 2;
+        if (pid_index_rebuild(new_capacity) != 0) return -1;
+    }
     
-    if (temp_array == NULL) {
-        fprintf(stderr, "[ERROR] No se pudo asignar memoria para nuevo proceso\n");
-        return;
+    size_t pos = pid_index_hash(pid);
+    while (pid_index[pos].pid != 0 && pid_index[pos].pid != pid) {
+        pos = (pos + 1) & (pid_index_capacity - 1);
     }
+    if (pid_index[pos].pid == 0) pid_index_count++;
+    pid_index[pos].pid = pid;
+    pid_index[pos].slot = slot;
+    return 0;
+}
+
+/**
+ * Elimina un PID del índice con desplazamiento hacia atrás (sin marcas de borrado)
+ */
+static void pid_index_remove(pid_t pid) {
+    if (!pid_index) return;
     
-    procesos_activos = temp_array;
-    procesos_activos[num_procesos_activos].info = info;
-    procesos_activos[num_procesos_activos].encontrado = 1;
-    num_procesos_activos++;
+    size_t mask = pid_index_capacity - 1;
+    size_t pos = pid_index_hash(pid);
+    while (pid_index[pos].pid != pid) {
+        if (pid_index[pos].pid == 0) return;
+        pos = (pos + 1) & mask;
+    }
+    
+    size_t hole = pos;
+    size_t next = (pos + 1) & mask;
+    while (pid_index[next].pid != 0) {
+        size_t home = pid_index_hash(pid_index[next].pid);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            pid_index[hole] = pid_index[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
     
-    printf("[NUEVO PROCESO] PID: %d, Nombre: %s\n", info.pid, info.name);
+    pid_index[hole].pid = 0;
+    pid_index_count--;
 }
 
-static void remove_process(pid_t pid) {
-    int idx = find_process(pid);
-    if (idx == -1) return;
+/**
+ * Duplica la capacidad del slab de procesos y de sus columnas calientes.
+ * Las ranuras nuevas no se encadenan en la lista libre: se consumen en orden
+ * a través de procesos_high_water.
+ * 
+ * @return 0 si es exitoso, -1 si no hay memoria
+ */
+static int grow_process_slab(void) {
+    int new_capacity = procesos_capacidad ? procesos_capacidad * 2
+                                          : PROCESS_SLAB_INITIAL_CAPACITY;
+    size_t n = (size_t)new_capacity;
     
-    printf("[PROCESO TERMINADO] PID: %d, Nombre: %s\n", 
-           procesos_activos[idx].info.pid, procesos_activos[idx].info.name);
+    // Cada array se reasigna por separado: si uno falla, los que ya crecieron
+    // conservan su contenido y la capacidad del slab no cambia
+    ActiveProcess *temp_array = realloc(procesos_activos, n * sizeof(ActiveProcess));
+    if (temp_array) procesos_activos = temp_array;
+    pid_t *pids = realloc(proc_columns.pid, n * sizeof(pid_t));
+    if (pids) proc_columns.pid = pids;
+    unsigned long *starttimes = realloc(proc_columns.starttime, n * sizeof(unsigned long));
+    if (starttimes) proc_columns.starttime = starttimes;
+    float *cpu = realloc(proc_columns.cpu_usage, n * sizeof(float));
+    if (cpu) proc_columns.cpu_usage = cpu;
+    float *mem = realloc(proc_columns.mem_usage, n * sizeof(float));
+    if (mem) proc_columns.mem_usage = mem;
+    float *io = realloc(proc_columns.io_kbps, n * sizeof(float));
+    if (io) proc_columns.io_kbps = io;
+    unsigned char *flags = realloc(proc_columns.flags, n * sizeof(unsigned char));
+    if (flags) proc_columns.flags = flags;
     
-    // Mover todos los elementos hacia la izquierda
-    for (int i = idx; i < num_procesos_activos - 1; i++) {
-        procesos_activos[i] = procesos_activos[i + 1];
+    if (!temp_array || !pids || !starttimes || !cpu || !mem || !io || !flags) {
+        fprintf(stderr, "[ERROR] No se pudo expandir el slab de procesos\n");
+        return -1;
     }
     
-    num_procesos_activos--;
+    // Las ranuras nuevas arrancan libres
+    size_t old = (size_t)procesos_capacidad;
+    memset(proc_columns.flags + old, 0, (n - old) * sizeof(unsigned char));
+    procesos_capacidad = new_capacity;
+    return 0;
+}
+
+/**
+ * Inserta un proceso en una ranura libre del slab. En régimen estable la
+ * ranura sale de la lista libre y no se realiza ninguna asignación.
+ * 
+ * @return int: Índice de la ranura, o -1 si no hay memoria
+ */
+static int add_process(const ProcessInfo *info, unsigned long starttime) {
+    int idx;
     
-    if (num_procesos_activos > 0) {
-        // Usar temp pointer para evitar perder referencia en caso de fallo de realloc
-        ActiveProcess *temp_array = realloc(procesos_activos, 
-                                           num_procesos_activos * sizeof(ActiveProcess));
-        // Solo actualizar si realloc fue exitoso (temp_array != NULL)
-        // Si falla, mantenemos el array original que sigue siendo válido
-        if (temp_array != NULL) {
-            procesos_activos = temp_array;
-        }
-        // Si temp_array es NULL, simplemente mantenemos el array original
-        // aunque será un poco más grande de lo necesario
+    const char *name = string_pool_intern(info->name);
+    if (!name) {
+        fprintf(stderr, "[ERROR] No se pudo asignar memoria para nuevo proceso\n");
+        return -1;
+    }
+    
+    if (primera_ranura_libre != -1) {
+        idx = primera_ranura_libre;
+        primera_ranura_libre = procesos_activos[idx].next_free;
     } else {
-        // Si no quedan procesos, liberar completamente
-        free(procesos_activos);
-        procesos_activos = NULL;
+        if (procesos_high_water >= procesos_capacidad && grow_process_slab() != 0) {
+            fprintf(stderr, "[ERROR] No se pudo asignar memoria para nuevo proceso\n");
+            string_pool_release(name);
+            return -1;
+        }
+        idx = procesos_high_water++;
+    }
+    
+    procesos_activos[idx].name = name;
+    procesos_activos[idx].next_free = -1;
+    proc_columns.pid[idx] = info->pid;
+    proc_columns.starttime[idx] = starttime;
+    proc_columns.flags[idx] = SLOT_IN_USE;
+    update_process(info, idx);
+    num_procesos_activos++;
+    
+    if (!history_configured) {
+        history_configure(config.history_length, (size_t)config.history_max_kb * 1024);
+        history_configured = 1;
+    }
+    procesos_activos[idx].history_ring = history_alloc(info->pid, starttime);
+    procesos_activos[idx].investigated = 0;
+    // Sin programación previa: el próximo ciclo completo lo lee
+    procesos_activos[idx].sampling_tier = SAMPLE_TIER_NORMAL;
+    procesos_activos[idx].next_sample.tv_sec = 0;
+    procesos_activos[idx].next_sample.tv_nsec = 0;
+    procesos_activos[idx].parent_slot = -1;
+    procesos_activos[idx].first_child = -1;
+    procesos_activos[idx].next_sibling = -1;
+    procesos_activos[idx].prev_sibling = -1;
+    procesos_activos[idx].subtree_child_exceeds = 0;
+    procesos_activos[idx].subtree_exceeds_since = 0;
+    memory_trend_reset(&procesos_activos[idx].memory_trend);
+    procesos_activos[idx].exe_checked = 0;
+    
+    if (pid_index_insert(info->pid, idx) != 0) {
+        // Sin índice el proceso sería inalcanzable: deshacer la inserción
+        proc_columns.flags[idx] = 0;
+        procesos_activos[idx].next_free = primera_ranura_libre;
+        primera_ranura_libre = idx;
+        num_procesos_activos--;
+        history_release(procesos_activos[idx].history_ring);
+        string_pool_release(procesos_activos[idx].name);
+        procesos_activos[idx].name = NULL;
+        return -1;
     }
+    tree_update_parent(idx);
+    
+    monitor_log("[NUEVO PROCESO] PID: %d, Nombre: %s\n", info->pid, info->name);
+    return idx;
+}
+
+/**
+ * Libera la ranura de un proceso terminado devolviéndola a la lista libre
+ */
+static void remove_process(int idx) {
+    if (idx < 0 || idx >= procesos_high_water || !(proc_columns.flags[idx] & SLOT_IN_USE)) return;
+    
+    monitor_log("[PROCESO TERMINADO] PID: %d, Nombre: %s\n", 
+                proc_columns.pid[idx], procesos_activos[idx].name);
+    
+    pid_index_remove(proc_columns.pid[idx]);
+    tree_remove(idx);
+    whitelist_forget(proc_columns.pid[idx], proc_columns.starttime[idx]);
+    history_release(procesos_activos[idx].history_ring);
+    procesos_activos[idx].history_ring = -1;
+    procesos_activos[idx].investigated = 0;
+    set_sampling_tier(idx, SAMPLE_TIER_NORMAL);
+    string_pool_release(procesos_activos[idx].name);
+    procesos_activos[idx].name = NULL;
+    proc_columns.flags[idx] = 0;
+    procesos_activos[idx].next_free = primera_ranura_libre;
+    primera_ranura_libre = idx;
+    num_procesos_activos--;
+}
+
+/**
+ * Agrega la muestra del ciclo al anillo de historial del proceso
+ */
+static void record_process_history(const ProcessInfo *info, const struct timespec *taken, int idx) {
+    history_record(procesos_activos[idx].history_ring, taken, info->cpu_usage, info->mem_usage,
+                   info->rss_kb, (unsigned long)info->io_kbps);
 }
 
-static void update_process(ProcessInfo info, int idx) {
-    if (idx < 0 || idx >= num_procesos_activos || procesos_activos == NULL) {
+static void update_process(const ProcessInfo *info, int idx) {
+    if (idx < 0 || idx >= procesos_high_water || procesos_activos == NULL ||
+        !(proc_columns.flags[idx] & SLOT_IN_USE)) {
         fprintf(stderr, "[ERROR] Índice inválido en update_process: %d (max: %d)\n", 
-                idx, num_procesos_activos - 1);
+                idx, procesos_high_water - 1);
         return;
     }
     
-    procesos_activos[idx].info = info;
-    procesos_activos[idx].encontrado = 1;
+    // Único punto donde cambian los campos muestreados de una ranura viva.
+    // El nombre lo mantienen add_process() y los cambios por exec().
+    ActiveProcess *slot = &procesos_activos[idx];
+    proc_columns.cpu_usage[idx] = info->cpu_usage;
+    proc_columns.mem_usage[idx] = info->mem_usage;
+    proc_columns.io_kbps[idx] = info->io_kbps;
+    proc_columns.flags[idx] |= SLOT_FOUND;
+    if (info->state.alerta_activa) {
+        proc_columns.flags[idx] |= SLOT_ALERT;
+    } else {
+        proc_columns.flags[idx] &= (unsigned char)~SLOT_ALERT;
+    }
+    
+    slot->ppid = info->ppid;
+    slot->cpu_time = info->cpu_time;
+    slot->is_whitelisted = info->is_whitelisted;
+    slot->rss_kb = info->rss_kb;
+    slot->pss_kb = info->pss_kb;
+    slot->swap_kb = info->swap_kb;
+    slot->mem_precise = info->mem_precise;
+    slot->io_read_kbps = info->io_read_kbps;
+    slot->io_write_kbps = info->io_write_kbps;
+    slot->syscr_rate = info->syscr_rate;
+    slot->syscw_rate = info->syscw_rate;
+    slot->num_hot_threads = info->num_hot_threads;
+    memcpy(slot->hot_threads, info->hot_threads,
+           (size_t)info->num_hot_threads * sizeof(ThreadCpuInfo));
+    slot->state = info->state;
+}
+
+/**
+ * Arma la ProcessInfo pública de una ranura a partir de sus columnas, su
+ * registro frío y el nombre internado
+ */
+static void slot_to_info(int idx, ProcessInfo *info) {
+    const ActiveProcess *slot = &procesos_activos[idx];
+    
+    info->pid = proc_columns.pid[idx];
+    info->ppid = slot->ppid;
+    size_t name_len = strlen(slot->name);
+    if (name_len >= sizeof(info->name)) name_len = sizeof(info->name) - 1;
+    memcpy(info->name, slot->name, name_len);
+    info->name[name_len] = '\0';
+    info->cpu_usage = proc_columns.cpu_usage[idx];
+    info->cpu_time = slot->cpu_time;
+    info->mem_usage = proc_columns.mem_usage[idx];
+    info->is_whitelisted = slot->is_whitelisted;
+    info->rss_kb = slot->rss_kb;
+    info->pss_kb = slot->pss_kb;
+    info->swap_kb = slot->swap_kb;
+    info->mem_precise = slot->mem_precise;
+    info->io_kbps = proc_columns.io_kbps[idx];
+    info->io_read_kbps = slot->io_read_kbps;
+    info->io_write_kbps = slot->io_write_kbps;
+    info->syscr_rate = slot->syscr_rate;
+    info->syscw_rate = slot->syscw_rate;
+    info->num_hot_threads = slot->num_hot_threads;
+    memcpy(info->hot_threads, slot->hot_threads,
+           (size_t)slot->num_hot_threads * sizeof(ThreadCpuInfo));
+    info->is_cgroup = 0;
+    info->state = slot->state;
+}
+
+/**
+ * Cambia el nivel de muestreo de un proceso manteniendo el conteo del nivel rápido
+ */
+static void set_sampling_tier(int idx, SamplingTier tier) {
+    SamplingTier old_tier = procesos_activos[idx].sampling_tier;
+    if (old_tier == tier) return;
+    
+    if (old_tier == SAMPLE_TIER_FAST) {
+        num_fast_processes--;
+        proc_columns.flags[idx] &= (unsigned char)~SLOT_FAST;
+    }
+    if (tier == SAMPLE_TIER_FAST) {
+        num_fast_processes++;
+        proc_columns.flags[idx] |= SLOT_FAST;
+    }
+    procesos_activos[idx].sampling_tier = tier;
+}
+
+/**
+ * Decide cada cuánto volver a leer un proceso según su última muestra:
+ * - Rápido: en investigación, en alerta o por encima de fast_sampling_fraction
+ *   de algún umbral, para que las alertas se confirmen cuanto antes
+ * - Lento: en whitelist (nunca alerta) o con CPU casi nula y sin que crezca
+ *   su RSS, para no dejar sin muestras al detector de fugas
+ * - Normal: el resto, una vez por ciclo
+ * 
+ * En la primera muestra de un proceso el CPU% es el promedio de toda su vida,
+ * que no dice si está inactivo ahora: se mantiene en el nivel normal.
+ */
+static void schedule_next_sample(int idx, const struct timespec *taken, int first_sample) {
+    ActiveProcess *ap = &procesos_activos[idx];
+    float cpu_usage = proc_columns.cpu_usage[idx];
+    SamplingTier tier;
+    long delay_ms;
+    
+    if (ap->investigated) {
+        tier = SAMPLE_TIER_FAST;
+    } else if (ap->is_whitelisted) {
+        tier = SAMPLE_TIER_SLOW;
+    } else if ((proc_columns.flags[idx] & SLOT_ALERT) || ap->state.exceeds_thresholds ||
+               cpu_usage >= config.max_cpu_usage * config.fast_sampling_fraction ||
+               (config.max_io_kbps > 0 &&
+                proc_columns.io_kbps[idx] >= config.max_io_kbps * config.fast_sampling_fraction) ||
+               proc_columns.mem_usage[idx] >= config.max_ram_usage * config.fast_sampling_fraction) {
+        tier = SAMPLE_TIER_FAST;
+    } else if (!first_sample && cpu_usage < IDLE_CPU_THRESHOLD &&
+               !(config.growth_window > 0 && ap->memory_trend.last_step_kbps >=
+                 config.growth_min_kbps * config.fast_sampling_fraction)) {
+        tier = SAMPLE_TIER_SLOW;
+    } else {
+        tier = SAMPLE_TIER_NORMAL;
+    }
+    
+    switch (tier) {
+        case SAMPLE_TIER_FAST:
+            delay_ms = config.fast_interval_ms;
+            break;
+        case SAMPLE_TIER_SLOW:
+            delay_ms = (long)config.slow_interval * 1000;
+            break;
+        default:
+            delay_ms = (long)config.check_interval * 1000;
+            break;
+    }
+    
+    // Bajo presión del sistema todos los niveles se estiran por igual
+    delay_ms *= pressure_interval_factor(pressure_state.level);
+    
+    set_sampling_tier(idx, tier);
+    ap->next_sample = *taken;
+    timespec_add_ms(&ap->next_sample, delay_ms);
+}
+
+/**
+ * Actualiza un proceso ya registrado con una muestra nueva conservando su
+ * estado de alerta, y reevalúa la alerta con los valores nuevos. La muestra
+ * recibe el estado acumulado de la ranura, la máquina de alertas trabaja
+ * sobre ella y update_process() la guarda completa.
+ */
+static void refresh_process(ProcessInfo *info, int idx) {
+    ActiveProcess *existing = &procesos_activos[idx];
+    
+    float cpu_change = info->cpu_usage - proc_columns.cpu_usage[idx];
+    float mem_change = info->mem_usage - proc_columns.mem_usage[idx];
+    int renamed = strcmp(info->name, existing->name) != 0;
+    int changed = cpu_change >= DELTA_CPU_MIN_CHANGE || -cpu_change >= DELTA_CPU_MIN_CHANGE ||
+                  mem_change >= DELTA_MEM_MIN_CHANGE || -mem_change >= DELTA_MEM_MIN_CHANGE ||
+                  renamed;
+    
+    // Los agregados del subárbol se recalculan en los ciclos completos y el
+    // ajuste del RSS después, en update_memory_trend()
+    info->state = existing->state;
+    
+    // Un cambio de nombre indica exec(): el ejecutable se vuelve a revisar
+    if (renamed) {
+        const char *name = string_pool_intern(info->name);
+        if (name) {
+            string_pool_release(existing->name);
+            existing->name = name;
+        }
+        info->state.exe_flags = 0;
+        info->state.exe_sha256[0] = '\0';
+        existing->exe_checked = 0;
+    }
+    
+    // Verificar y actualizar estado de alerta
+    check_and_update_alert_status(info);
+    update_process(info, idx);
+    
+    // El ppid cambia cuando init o un subreaper adopta al proceso
+    tree_update_parent(idx);
+    
+    if (changed) {
+        delta_record(DELTA_CHANGED, info, 0);
+    }
 }
 
 static void clear_process_list(void) {
@@ -987,46 +4040,68 @@ static void clear_process_list(void) {
         free(procesos_activos);
         procesos_activos = NULL;
     }
+    free(proc_columns.pid);
+    free(proc_columns.starttime);
+    free(proc_columns.cpu_usage);
+    free(proc_columns.mem_usage);
+    free(proc_columns.io_kbps);
+    free(proc_columns.flags);
+    memset(&proc_columns, 0, sizeof(proc_columns));
+    free(pid_index);
+    pid_index = NULL;
+    pid_index_capacity = 0;
+    pid_index_count = 0;
     num_procesos_activos = 0;
+    procesos_capacidad = 0;
+    procesos_high_water = 0;
+    primera_ranura_libre = -1;
+    num_fast_processes = 0;
+    free(tree_order);
+    tree_order = NULL;
+    tree_order_capacity = 0;
+    history_cleanup();
+    history_configured = 0;
+    string_pool_clear();
     printf("[INFO] Lista de procesos activos limpiada\n");
 }
 
-static void show_process_stats(void) {
-    printf("\n=== ESTADÍSTICAS DE PROCESOS ACTIVOS ===\n");
-    printf("Total de procesos monitoreados: %d\n", num_procesos_activos);
+/**
+ * Cuenta los procesos por encima de cada umbral recorriendo solo las
+ * columnas calientes: unos pocos bytes contiguos por proceso en lugar de
+ * una ranura completa
+ */
+static void count_threshold_columns(ProcessSnapshot *snapshot) {
+    int high_cpu = 0, high_mem = 0, high_io = 0, alerts = 0;
+    float max_cpu = config.max_cpu_usage;
+    float max_ram = config.max_ram_usage;
+    float max_io = config.max_io_kbps;
     
-    int alertas_cpu = 0, alertas_mem = 0;
-    for (int i = 0; i < num_procesos_activos; i++) {
-        ProcessInfo *p = &procesos_activos[i].info;
-        if (p->cpu_usage > config.max_cpu_usage) alertas_cpu++;
-        if (p->mem_usage > config.max_ram_usage) alertas_mem++;
+    for (int i = 0; i < procesos_high_water; i++) {
+        if (!(proc_columns.flags[i] & SLOT_IN_USE)) continue;
+        high_cpu += proc_columns.cpu_usage[i] > max_cpu;
+        high_mem += proc_columns.mem_usage[i] > max_ram;
+        high_io += max_io > 0 && proc_columns.io_kbps[i] > max_io;
+        alerts += (proc_columns.flags[i] & SLOT_ALERT) != 0;
     }
     
-    printf("Procesos con alta CPU: %d\n", alertas_cpu);
-    printf("Procesos con alta memoria: %d\n", alertas_mem);
-    printf("=========================================\n\n");
+    snapshot->high_cpu_count = high_cpu;
+    snapshot->high_memory_count = high_mem;
+    snapshot->high_io_count = high_io;
+    snapshot->active_alerts = alerts;
 }
 
-// ===== FUNCIONES DE LIMPIEZA =====
-
-void cleanup_temp_files(void) {
-    printf("[INFO] Limpiando archivos temporales de estadísticas...\n");
-    
-    // Eliminar archivos temporales del directorio /tmp
-    int result = system("rm -f /tmp/procstat_*.dat 2>/dev/null");
-    if (result == 0) {
-        printf("[INFO] Archivos temporales limpiados exitosamente\n");
-    } else {
-        printf("[WARNING] No se pudieron limpiar algunos archivos temporales\n");
+static void show_process_stats(const ProcessSnapshot *snapshot) {
+    monitor_log("\n=== ESTADÍSTICAS DE PROCESOS ACTIVOS ===\n");
+    monitor_log("Total de procesos monitoreados: %d\n", snapshot->count);
+    monitor_log("Procesos con alta CPU: %d\n", snapshot->high_cpu_count);
+    monitor_log("Procesos con alta memoria: %d\n", snapshot->high_memory_count);
+    if (config.max_io_kbps > 0) {
+        monitor_log("Procesos con alta E/S: %d\n", snapshot->high_io_count);
     }
-}
-
-void cleanup_stale_temp_files(void) {
-    printf("[INFO] Limpiando archivos temporales antiguos...\n");
-
-    if (system("find /tmp -name 'procstat_*.dat' -mtime +1 -delete 2>/dev/null") == 0) {
-        printf("[INFO] Archivos temporales antiguos limpiados exitosamente\n");
-    } else {
-        printf("[WARNING] No se pudieron limpiar algunos archivos temporales viejos\n");
+    int shown = snapshot->top_count[TOP_BY_CPU] < 3 ? snapshot->top_count[TOP_BY_CPU] : 3;
+    for (int i = 0; i < shown; i++) {
+        const ProcessInfo *p = &snapshot->processes[snapshot->top[TOP_BY_CPU][i]];
+        monitor_log("Top CPU %d: %s (PID %d) %.2f%%\n", i + 1, p->name, p->pid, p->cpu_usage);
     }
-}
\ No newline at end of file
+    monitor_log("=========================================\n\n");
+}
@@ -46,12 +46,61 @@ void on_high_memory_alert_callback(ProcessInfo *info) {
     // Aquí la GUI podría mostrar una notificación de alerta
 }
 
+void on_high_io_alert_callback(ProcessInfo *info) {
+    printf("💽 [GUI ALERT] Alta E/S: %s (PID: %d) - lectura %.1f kB/s, escritura %.1f kB/s\n", 
+           info->name, info->pid, info->io_read_kbps, info->io_write_kbps);
+    // Aquí la GUI podría mostrar una notificación de alerta
+}
+
+void on_subtree_alert_callback(ProcessInfo *root) {
+    printf("🌳 [GUI ALERT] Subárbol de %s (PID: %d): %d procesos - CPU %.2f%%, MEM %.2f%%\n", 
+           root->name, root->pid, root->state.subtree_processes,
+           root->state.subtree_cpu_usage, root->state.subtree_mem_usage);
+    // Aquí la GUI podría mostrar el árbol con get_process_subtree()
+}
+
+void on_memory_growth_alert_callback(ProcessInfo *info) {
+    printf("📈 [GUI ALERT] Posible fuga de memoria: %s (PID: %d) - %.1f kB/s, R² %.2f\n", 
+           info->name, info->pid, info->state.mem_growth_kbps, info->state.mem_growth_r2);
+    // Aquí la GUI podría graficar la serie con get_process_history()
+}
+
+void on_executable_alert_callback(ProcessInfo *info) {
+    printf("🧬 [GUI ALERT] Ejecutable sospechoso: %s (PID: %d) - %s\n", 
+           info->name, info->pid,
+           (info->state.exe_flags & EXE_FLAG_MEMFD) ? "en memoria (memfd)" : "borrado del disco");
+    // Aquí la GUI podría mostrar exe_sha256 cuando esté calculado
+}
+
+void on_pressure_alert_callback(const SystemPressure *pressure, PsiResource resource) {
+    const PsiStats *stats = &pressure->resources[resource];
+    printf("🌡️  [GUI ALERT] Presión de %s sostenida: some avg10 %.1f%%, full avg10 %.1f%% (regulador %s)\n", 
+           pressure_resource_name(resource), stats->some.avg10, stats->full.avg10,
+           pressure_level_name(pressure->level));
+    // Aquí la GUI podría mostrar un indicador de sistema saturado
+}
+
+void on_pressure_cleared_callback(const SystemPressure *pressure, PsiResource resource) {
+    printf("✅ [GUI EVENT] Presión de %s normalizada: some avg10 %.1f%%\n", 
+           pressure_resource_name(resource), pressure->resources[resource].some.avg10);
+}
+
 void on_alert_cleared_callback(ProcessInfo *info) {
     printf("✅ [GUI EVENT] Alerta despejada: %s (PID: %d)\n", 
            info->name, info->pid);
     // Aquí la GUI podría limpiar las notificaciones
 }
 
+void on_cycle_delta_callback(const ProcessDelta *delta) {
+    if (delta->num_added == 0 && delta->num_removed == 0 && delta->num_alerts_raised == 0 &&
+        delta->num_alerts_cleared == 0 && delta->num_alerts_suppressed == 0 &&
+        delta->stalls_raised == 0 && delta->stalls_cleared == 0) return;
+    printf("🔄 [GUI DELTA] Ciclo %lu: +%d -%d ~%d, alertas +%d -%d (%d retenidas)\n",
+           delta->cycle, delta->num_added, delta->num_removed, delta->num_changed,
+           delta->num_alerts_raised, delta->num_alerts_cleared, delta->num_alerts_suppressed);
+    // Aquí la GUI podría aplicar todos los cambios en una sola actualización
+}
+
 // Función para mostrar estadísticas periódicamente
 void show_periodic_stats() {
     MonitoringStats stats = get_monitoring_stats();
@@ -87,6 +136,24 @@ void show_process_list() {
     free(processes);
 }
 
+// Función para mostrar los procesos que más consumen sin copiar la lista completa
+void show_top_processes() {
+    ProcessInfo top[5];
+    int count = get_top_processes(TOP_BY_CPU, top, 5);
+    
+    printf("🔥 === TOP CPU ===\n");
+    for (int i = 0; i < count; i++) {
+        printf("   %d. PID: %d | %s | CPU: %.2f%%\n", i + 1, top[i].pid, top[i].name, top[i].cpu_usage);
+    }
+    
+    count = get_top_processes(TOP_BY_RSS, top, 5);
+    printf("🧠 === TOP MEMORIA ===\n");
+    for (int i = 0; i < count; i++) {
+        printf("   %d. PID: %d | %s | RSS: %lu kB\n", i + 1, top[i].pid, top[i].name, top[i].rss_kb);
+    }
+    printf("==================\n\n");
+}
+
 int main() {
     printf("🚀 === EJEMPLO DE MONITOREO CON HILOS ===\n\n");
     
@@ -108,7 +175,14 @@ int main() {
         .on_process_terminated = on_process_terminated_callback,
         .on_high_cpu_alert = on_high_cpu_alert_callback,
         .on_high_memory_alert = on_high_memory_alert_callback,
-        .on_alert_cleared = on_alert_cleared_callback
+        .on_alert_cleared = on_alert_cleared_callback,
+        .on_high_io_alert = on_high_io_alert_callback,
+        .on_subtree_alert = on_subtree_alert_callback,
+        .on_memory_growth_alert = on_memory_growth_alert_callback,
+        .on_executable_alert = on_executable_alert_callback,
+        .on_pressure_alert = on_pressure_alert_callback,
+        .on_pressure_cleared = on_pressure_cleared_callback,
+        .on_cycle_delta = on_cycle_delta_callback
     };
     set_process_callbacks(&callbacks);
     
@@ -128,6 +202,7 @@ int main() {
         stats_counter += 5;
         if (stats_counter >= 20) {
             show_periodic_stats();
+            show_top_processes();
             show_process_list();
             stats_counter = 0;
         }
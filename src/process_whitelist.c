@@ -0,0 +1,387 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <limits.h>
+#include <pthread.h>
+#include "process_whitelist.h"
+
+#define WHITELIST_CMDLINE_BUFFER_SIZE 4096
+#define WHITELIST_CACHE_INITIAL_CAPACITY 1024
+// Si la caché llega a este tamaño se vacía: acota veredictos de procesos
+// que se consultaron sin llegar a la tabla de procesos activos
+#define WHITELIST_CACHE_MAX_ENTRIES 65536
+
+// Prefijos que eligen el dato comparado en una entrada de WHITELIST
+#define WHITELIST_EXE_PREFIX "exe:"
+#define WHITELIST_CMDLINE_PREFIX "cmdline:"
+
+// ============================================================================
+// ESTADO DEL MATCHER
+// ============================================================================
+
+// Conjunto hash de nombres exactos (direccionamiento abierto, capacidad potencia de 2)
+static char **name_set = NULL;
+static size_t name_set_capacity = 0;
+
+static WhitelistPattern *patterns = NULL;
+static int num_patterns = 0;
+static int has_name_patterns = 0;
+static int has_detail_patterns = 0;  // Patrones sobre exe o cmdline
+
+static WhitelistVerdict *verdicts = NULL;
+static size_t verdicts_capacity = 0;
+static size_t verdicts_count = 0;
+
+// Los hilos de muestreo consultan la caché en paralelo
+static pthread_mutex_t whitelist_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// ============================================================================
+// FUNCIONES AUXILIARES
+// ============================================================================
+
+/**
+ * FNV-1a de 64 bits sobre el nombre
+ */
+static size_t name_hash(const char *name) {
+    unsigned long long h = 1469598103934665603ULL;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    return (size_t)h;
+}
+
+static size_t verdict_hash(pid_t pid, unsigned long starttime) {
+    unsigned long h = (unsigned long)(unsigned int)pid * 2654435761UL;
+    h ^= starttime + 0x9e3779b9UL + (h << 6) + (h >> 2);
+    return (size_t)h;
+}
+
+static int name_set_contains(const char *name) {
+    if (!name_set) return 0;
+    size_t mask = name_set_capacity - 1;
+    for (size_t pos = name_hash(name) & mask; name_set[pos]; pos = (pos + 1) & mask) {
+        if (strcmp(name_set[pos], name) == 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * Inserta un nombre en el conjunto (sin duplicados). La capacidad se fija
+ * al compilar para que el factor de carga quede por debajo de 1/2.
+ * @return int: 1 si se insertó, 0 si ya estaba, -1 si no hay memoria
+ */
+static int name_set_insert(const char *name) {
+    size_t mask = name_set_capacity - 1;
+    size_t pos = name_hash(name) & mask;
+    while (name_set[pos]) {
+        if (strcmp(name_set[pos], name) == 0) return 0;
+        pos = (pos + 1) & mask;
+    }
+    name_set[pos] = strdup(name);
+    return name_set[pos] ? 1 : -1;
+}
+
+/**
+ * Clasifica el patrón: exacto sin metacaracteres, prefijo si el único
+ * metacarácter es un '*' final, glob general en otro caso
+ */
+static WhitelistMatchKind classify_pattern(const char *pattern, size_t *prefix_len) {
+    size_t len = strlen(pattern);
+    size_t first_meta = strcspn(pattern, "*?[\\");
+    *prefix_len = first_meta;
+    if (first_meta == len) return WHITELIST_MATCH_EXACT;
+    if (first_meta == len - 1 && pattern[first_meta] == '*') return WHITELIST_MATCH_PREFIX;
+    return WHITELIST_MATCH_GLOB;
+}
+
+static int pattern_matches(const WhitelistPattern *p, const char *text) {
+    switch (p->kind) {
+        case WHITELIST_MATCH_EXACT:
+            return strcmp(text, p->pattern) == 0;
+        case WHITELIST_MATCH_PREFIX:
+            return strncmp(text, p->pattern, p->prefix_len) == 0;
+        case WHITELIST_MATCH_GLOB:
+        default:
+            return fnmatch(p->pattern, text, 0) == 0;
+    }
+}
+
+static int match_name_locked(const char *name) {
+    if (name_set_contains(name)) return 1;
+    if (!has_name_patterns) return 0;
+    for (int i = 0; i < num_patterns; i++) {
+        if (patterns[i].target == WHITELIST_TARGET_NAME && pattern_matches(&patterns[i], name)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Compara los patrones de exe y cmdline. Cada archivo se lee solo si hay
+ * algún patrón que lo necesite.
+ */
+static int match_details_locked(int pid_fd) {
+    char exe[PATH_MAX];
+    char cmdline[WHITELIST_CMDLINE_BUFFER_SIZE];
+    int exe_state = 0;       // 0 sin leer, 1 leído, -1 no disponible
+    int cmdline_state = 0;
+
+    for (int i = 0; i < num_patterns; i++) {
+        const WhitelistPattern *p = &patterns[i];
+
+        if (p->target == WHITELIST_TARGET_EXE) {
+            if (exe_state == 0) {
+                ssize_t len = readlinkat(pid_fd, "exe", exe, sizeof(exe) - 1);
+                exe_state = len > 0 ? 1 : -1;
+                if (len > 0) exe[len] = '\0';
+            }
+            if (exe_state == 1 && pattern_matches(p, exe)) return 1;
+        } else if (p->target == WHITELIST_TARGET_CMDLINE) {
+            if (cmdline_state == 0) {
+                cmdline_state = -1;
+                int fd = openat(pid_fd, "cmdline", O_RDONLY | O_CLOEXEC);
+                if (fd >= 0) {
+                    ssize_t len = read(fd, cmdline, sizeof(cmdline) - 1);
+                    close(fd);
+                    // Los hilos del kernel no tienen cmdline
+                    if (len > 0) {
+                        for (ssize_t j = 0; j < len; j++) {
+                            if (cmdline[j] == '\0') cmdline[j] = ' ';
+                        }
+                        while (len > 0 && cmdline[len - 1] == ' ') len--;
+                        cmdline[len] = '\0';
+                        cmdline_state = 1;
+                    }
+                }
+            }
+            if (cmdline_state == 1 && pattern_matches(p, cmdline)) return 1;
+        }
+    }
+    return 0;
+}
+
+static void verdicts_clear(void) {
+    if (verdicts) memset(verdicts, 0, verdicts_capacity * sizeof(WhitelistVerdict));
+    verdicts_count = 0;
+}
+
+static int verdicts_grow(void) {
+    size_t new_capacity = verdicts_capacity ? verdicts_capacity * 2 : WHITELIST_CACHE_INITIAL_CAPACITY;
+    WhitelistVerdict *new_table = calloc(new_capacity, sizeof(WhitelistVerdict));
+    if (!new_table) return -1;
+
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < verdicts_capacity; i++) {
+        if (verdicts[i].pid == 0) continue;
+        size_t pos = verdict_hash(verdicts[i].pid, verdicts[i].starttime) & mask;
+        while (new_table[pos].pid) pos = (pos + 1) & mask;
+        new_table[pos] = verdicts[i];
+    }
+
+    free(verdicts);
+    verdicts = new_table;
+    verdicts_capacity = new_capacity;
+    return 0;
+}
+
+static WhitelistVerdict* verdict_find(pid_t pid, unsigned long starttime, size_t *slot) {
+    if (!verdicts) return NULL;
+    size_t mask = verdicts_capacity - 1;
+    size_t pos = verdict_hash(pid, starttime) & mask;
+    while (verdicts[pos].pid) {
+        if (verdicts[pos].pid == pid && verdicts[pos].starttime == starttime) {
+            if (slot) *slot = pos;
+            return &verdicts[pos];
+        }
+        pos = (pos + 1) & mask;
+    }
+    if (slot) *slot = pos;
+    return NULL;
+}
+
+/**
+ * Borra una entrada desplazando hacia atrás las siguientes del mismo
+ * grupo, para que las búsquedas lineales no necesiten lápidas
+ */
+static void verdict_delete_at(size_t hole) {
+    size_t mask = verdicts_capacity - 1;
+    size_t i = (hole + 1) & mask;
+    while (verdicts[i].pid) {
+        size_t home = verdict_hash(verdicts[i].pid, verdicts[i].starttime) & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            verdicts[hole] = verdicts[i];
+            hole = i;
+        }
+        i = (i + 1) & mask;
+    }
+    verdicts[hole].pid = 0;
+    verdicts_count--;
+}
+
+static void free_compiled(void) {
+    for (size_t i = 0; i < name_set_capacity; i++) {
+        free(name_set[i]);
+    }
+    free(name_set);
+    name_set = NULL;
+    name_set_capacity = 0;
+
+    for (int i = 0; i < num_patterns; i++) {
+        free(patterns[i].pattern);
+    }
+    free(patterns);
+    patterns = NULL;
+    num_patterns = 0;
+    has_name_patterns = 0;
+    has_detail_patterns = 0;
+}
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+int whitelist_compile(char **entries, int count) {
+    pthread_mutex_lock(&whitelist_mutex);
+    free_compiled();
+    verdicts_clear();
+
+    if (count <= 0 || !entries) {
+        pthread_mutex_unlock(&whitelist_mutex);
+        return 0;
+    }
+
+    name_set_capacity = 16;
+    while (name_set_capacity < (size_t)count * 2) name_set_capacity *= 2;
+    name_set = calloc(name_set_capacity, sizeof(char*));
+    patterns = calloc((size_t)count, sizeof(WhitelistPattern));
+    if (!name_set || !patterns) {
+        free_compiled();
+        pthread_mutex_unlock(&whitelist_mutex);
+        fprintf(stderr, "[ERROR] No se pudo asignar memoria para compilar la whitelist\n");
+        return -1;
+    }
+
+    int exact_names = 0;
+    for (int i = 0; i < count; i++) {
+        const char *entry = entries[i];
+        if (!entry || entry[0] == '\0') continue;
+
+        WhitelistTarget target = WHITELIST_TARGET_NAME;
+        if (strncmp(entry, WHITELIST_EXE_PREFIX, strlen(WHITELIST_EXE_PREFIX)) == 0) {
+            target = WHITELIST_TARGET_EXE;
+            entry += strlen(WHITELIST_EXE_PREFIX);
+        } else if (strncmp(entry, WHITELIST_CMDLINE_PREFIX, strlen(WHITELIST_CMDLINE_PREFIX)) == 0) {
+            target = WHITELIST_TARGET_CMDLINE;
+            entry += strlen(WHITELIST_CMDLINE_PREFIX);
+        }
+        if (entry[0] == '\0') continue;
+
+        size_t prefix_len = 0;
+        WhitelistMatchKind kind = classify_pattern(entry, &prefix_len);
+
+        if (target == WHITELIST_TARGET_NAME && kind == WHITELIST_MATCH_EXACT) {
+            int inserted = name_set_insert(entry);
+            if (inserted < 0) {
+                fprintf(stderr, "[ERROR] No se pudo duplicar cadena para whitelist\n");
+            }
+            if (inserted > 0) exact_names++;
+            continue;
+        }
+
+        WhitelistPattern *p = &patterns[num_patterns];
+        p->pattern = strdup(entry);
+        if (!p->pattern) {
+            fprintf(stderr, "[ERROR] No se pudo duplicar cadena para whitelist\n");
+            continue;
+        }
+        p->prefix_len = prefix_len;
+        p->target = target;
+        p->kind = kind;
+        num_patterns++;
+
+        if (target == WHITELIST_TARGET_NAME) has_name_patterns = 1;
+        else has_detail_patterns = 1;
+    }
+
+    pthread_mutex_unlock(&whitelist_mutex);
+
+    printf("[INFO] Whitelist compilada: %d nombres exactos, %d patrones\n",
+           exact_names, num_patterns);
+    return 0;
+}
+
+int whitelist_match_name(const char *name) {
+    if (!name) return 0;
+    pthread_mutex_lock(&whitelist_mutex);
+    int result = match_name_locked(name);
+    pthread_mutex_unlock(&whitelist_mutex);
+    return result;
+}
+
+int whitelist_match_process(int pid_fd, pid_t pid, unsigned long starttime, const char *name) {
+    if (!name) return 0;
+    if (pid <= 0) return whitelist_match_name(name);
+
+    pthread_mutex_lock(&whitelist_mutex);
+
+    size_t slot = 0;
+    WhitelistVerdict *cached = verdict_find(pid, starttime, &slot);
+    if (cached && strncmp(cached->name, name, sizeof(cached->name) - 1) == 0) {
+        int result = cached->whitelisted;
+        pthread_mutex_unlock(&whitelist_mutex);
+        return result;
+    }
+
+    int result = match_name_locked(name);
+    if (!result && has_detail_patterns && pid_fd >= 0) {
+        result = match_details_locked(pid_fd);
+    }
+
+    if (!cached) {
+        // Mantener factor de carga por debajo de 1/2
+        if (verdicts_count >= WHITELIST_CACHE_MAX_ENTRIES) {
+            verdicts_clear();
+        }
+        if ((verdicts_count + 1) * 2 > verdicts_capacity && verdicts_grow() != 0) {
+            pthread_mutex_unlock(&whitelist_mutex);
+            return result;
+        }
+        verdict_find(pid, starttime, &slot);
+        cached = &verdicts[slot];
+        cached->pid = pid;
+        cached->starttime = starttime;
+        verdicts_count++;
+    }
+    // Un exec() cambia el comm sin cambiar (pid, starttime): se recalcula
+    strncpy(cached->name, name, sizeof(cached->name) - 1);
+    cached->name[sizeof(cached->name) - 1] = '\0';
+    cached->whitelisted = result;
+
+    pthread_mutex_unlock(&whitelist_mutex);
+    return result;
+}
+
+void whitelist_forget(pid_t pid, unsigned long starttime) {
+    pthread_mutex_lock(&whitelist_mutex);
+    size_t slot = 0;
+    if (verdict_find(pid, starttime, &slot)) {
+        verdict_delete_at(slot);
+    }
+    pthread_mutex_unlock(&whitelist_mutex);
+}
+
+void whitelist_cleanup(void) {
+    pthread_mutex_lock(&whitelist_mutex);
+    free_compiled();
+    free(verdicts);
+    verdicts = NULL;
+    verdicts_capacity = 0;
+    verdicts_count = 0;
+    pthread_mutex_unlock(&whitelist_mutex);
+}
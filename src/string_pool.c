@@ -0,0 +1,136 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "string_pool.h"
+
+#define STRING_POOL_INITIAL_CAPACITY 256
+
+// ============================================================================
+// ESTADO DEL POOL
+// ============================================================================
+
+// Tabla hash de direccionamiento abierto (capacidad potencia de 2)
+static PooledString *pool = NULL;
+static size_t pool_capacity = 0;
+static size_t pool_count = 0;
+
+// ============================================================================
+// FUNCIONES AUXILIARES
+// ============================================================================
+
+/**
+ * FNV-1a de 64 bits sobre la cadena
+ */
+static size_t string_hash(const char *str) {
+    unsigned long long h = 1469598103934665603ULL;
+    for (const unsigned char *p = (const unsigned char *)str; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    return (size_t)h;
+}
+
+static int pool_grow(void) {
+    size_t new_capacity = pool_capacity ? pool_capacity * 2 : STRING_POOL_INITIAL_CAPACITY;
+    PooledString *new_pool = calloc(new_capacity, sizeof(PooledString));
+    if (!new_pool) return -1;
+
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < pool_capacity; i++) {
+        if (!pool[i].str) continue;
+        size_t pos = pool[i].hash & mask;
+        while (new_pool[pos].str) pos = (pos + 1) & mask;
+        new_pool[pos] = pool[i];
+    }
+
+    free(pool);
+    pool = new_pool;
+    pool_capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * Vacía una ranura con desplazamiento hacia atrás (sin marcas de borrado)
+ */
+static void pool_delete_at(size_t hole) {
+    size_t mask = pool_capacity - 1;
+    free(pool[hole].str);
+
+    size_t next = (hole + 1) & mask;
+    while (pool[next].str) {
+        size_t home = pool[next].hash & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            pool[hole] = pool[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    memset(&pool[hole], 0, sizeof(PooledString));
+    pool_count--;
+}
+
+// ============================================================================
+// FUNCIONES PÚBLICAS
+// ============================================================================
+
+const char* string_pool_intern(const char *str) {
+    if (!str) return NULL;
+
+    size_t hash = string_hash(str);
+    if (pool) {
+        size_t mask = pool_capacity - 1;
+        for (size_t pos = hash & mask; pool[pos].str; pos = (pos + 1) & mask) {
+            if (pool[pos].hash == hash && strcmp(pool[pos].str, str) == 0) {
+                pool[pos].refs++;
+                return pool[pos].str;
+            }
+        }
+    }
+
+    // Factor de carga por debajo de 1/2 para sondeos cortos
+    if ((pool_count + 1) * 2 > pool_capacity && pool_grow() != 0) {
+        return NULL;
+    }
+
+    char *copy = strdup(str);
+    if (!copy) return NULL;
+
+    size_t mask = pool_capacity - 1;
+    size_t pos = hash & mask;
+    while (pool[pos].str) pos = (pos + 1) & mask;
+    pool[pos].str = copy;
+    pool[pos].hash = hash;
+    pool[pos].refs = 1;
+    pool_count++;
+    return copy;
+}
+
+void string_pool_release(const char *str) {
+    if (!str || !pool) return;
+
+    // Se busca por puntero: solo las copias del pool son válidas aquí
+    size_t mask = pool_capacity - 1;
+    for (size_t pos = string_hash(str) & mask; pool[pos].str; pos = (pos + 1) & mask) {
+        if (pool[pos].str == str) {
+            if (--pool[pos].refs == 0) {
+                pool_delete_at(pos);
+            }
+            return;
+        }
+    }
+}
+
+size_t string_pool_count(void) {
+    return pool_count;
+}
+
+void string_pool_clear(void) {
+    for (size_t i = 0; i < pool_capacity; i++) {
+        free(pool[i].str);
+    }
+    free(pool);
+    pool = NULL;
+    pool_capacity = 0;
+    pool_count = 0;
+}